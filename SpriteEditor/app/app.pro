@@ -0,0 +1,40 @@
+TARGET = SpiffySprites
+
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG += c++17
+CONFIG += console
+
+include(../core/core.pri)
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    animationpreview.cpp \
+    canvasview.cpp \
+    frameitemdelegate.cpp \
+    main.cpp \
+    mainwindow.cpp \
+    redrawscheduler.cpp \
+    thumbnailcache.cpp
+
+HEADERS += \
+    animationpreview.h \
+    canvasview.h \
+    frameitemdelegate.h \
+    mainwindow.h \
+    redrawscheduler.h \
+    thumbnailcache.h
+
+FORMS += \
+    animationpreview.ui \
+    mainwindow.ui
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
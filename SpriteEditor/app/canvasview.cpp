@@ -0,0 +1,175 @@
+#include "canvasview.h"
+#include <algorithm>
+#include <cmath>
+#include <QPaintEvent>
+#include <QPainter>
+
+// opacity of the previous frame when onion skinning
+static const double ONION_SKIN_OPACITY = 0.4;
+
+///
+/// \brief CanvasView::CanvasView constructor.
+/// \param parent used by Qt
+///
+CanvasView::CanvasView(QWidget *parent)
+    : QWidget(parent)
+{
+
+}
+
+///
+/// \brief CanvasView::showFrame replace everything shown with a new frame
+/// \param canvas the frame's canvas
+/// \param onionSkin canvas drawn partially transparent over the frame, or a null image for none
+///
+void CanvasView::showFrame(const QImage &canvas, const QImage &onionSkin)
+{
+    if (composite.size() != canvas.size())
+    {
+        composite = QImage(canvas.size(), QImage::Format_RGB32);
+    }
+    composeRect(composite.rect(), canvas, onionSkin);
+    rebuildUpscaled();
+    update();
+}
+
+///
+/// \brief CanvasView::updateRect redraw only part of the frame
+/// \param dirty area of the frame that changed
+/// \param canvas the frame's canvas
+/// \param onionSkin canvas drawn partially transparent over the frame, or a null image for none
+///
+void CanvasView::updateRect(const QRect &dirty, const QImage &canvas, const QImage &onionSkin)
+{
+    if (composite.size() != canvas.size())
+    {
+        showFrame(canvas, onionSkin);
+        return;
+    }
+    QRect rect = dirty & composite.rect();
+    if (rect.isEmpty())
+    {
+        return;
+    }
+    composeRect(rect, canvas, onionSkin);
+    upscaleRect(rect);
+    //Grow by a pixel so the edges of the rect are repainted even where the scaling rounds
+    update(frameToWidget().mapRect(QRectF(rect)).toAlignedRect().adjusted(-1, -1, 1, 1));
+}
+
+///
+/// \brief CanvasView::pixelAt map a point on the widget to the frame pixel under it
+/// \param pos point in widget coordinates
+/// \return frame pixel coordinates; may be outside the frame
+///
+QPoint CanvasView::pixelAt(const QPoint &pos) const
+{
+    QPointF pixel = frameToWidget().inverted().map(QPointF(pos));
+    return QPoint((int)std::floor(pixel.x()), (int)std::floor(pixel.y()));
+}
+
+///
+/// \brief CanvasView::paintEvent draw the exposed part of the upscaled frame
+/// \param event holds the area to repaint
+///
+void CanvasView::paintEvent(QPaintEvent *event)
+{
+    if (upscaled.isNull())
+    {
+        return;
+    }
+    QPainter painter(this);
+    painter.setClipRect(event->rect());
+    //The pixmap is a whole multiple of the frame; the transform makes up the rest of the fit
+    QTransform transform = frameToWidget();
+    transform.scale(1.0 / pixelScale, 1.0 / pixelScale);
+    painter.setTransform(transform);
+    painter.drawPixmap(0, 0, upscaled);
+}
+
+///
+/// \brief CanvasView::resizeEvent rebuild the upscaled frame for the new size
+/// \param event unused
+///
+void CanvasView::resizeEvent(QResizeEvent *event)
+{
+    Q_UNUSED(event);
+    rebuildUpscaled();
+}
+
+///
+/// \brief CanvasView::composeRect rebuild part of the composite
+/// \param rect area of the frame to rebuild, inside the composite
+/// \param canvas the frame's canvas
+/// \param onionSkin canvas drawn partially transparent over the frame, or a null image for none
+///
+void CanvasView::composeRect(const QRect &rect, const QImage &canvas, const QImage &onionSkin)
+{
+    QPainter painter(&composite);
+    painter.fillRect(rect, Qt::white);
+    painter.drawImage(rect.topLeft(), canvas, rect);
+    if (!onionSkin.isNull())
+    {
+        painter.setOpacity(ONION_SKIN_OPACITY);
+        painter.drawImage(rect.topLeft(), onionSkin, rect);
+    }
+}
+
+///
+/// \brief CanvasView::upscaleRect copy part of the composite into the upscaled pixmap
+/// \param rect area of the frame to copy
+///
+void CanvasView::upscaleRect(const QRect &rect)
+{
+    if (upscaled.isNull())
+    {
+        return;
+    }
+    QPainter painter(&upscaled);
+    painter.scale(pixelScale, pixelScale);
+    painter.drawImage(rect.topLeft(), composite, rect);
+}
+
+///
+/// \brief CanvasView::rebuildUpscaled pick the whole-number scale for the current widget size and upscale all of the composite
+///
+void CanvasView::rebuildUpscaled()
+{
+    if (composite.isNull() || width() <= 0 || height() <= 0)
+    {
+        upscaled = QPixmap();
+        return;
+    }
+    pixelScale = std::max(1, (int)std::floor(fitScale()));
+    if (upscaled.size() != composite.size() * pixelScale)
+    {
+        upscaled = QPixmap(composite.size() * pixelScale);
+    }
+    upscaleRect(composite.rect());
+}
+
+///
+/// \brief CanvasView::fitScale
+/// \return how many widget pixels wide a frame pixel is when the frame is fit into the widget
+///
+double CanvasView::fitScale() const
+{
+    if (composite.isNull())
+    {
+        return 1;
+    }
+    return std::min((double)width() / composite.width(), (double)height() / composite.height());
+}
+
+///
+/// \brief CanvasView::frameToWidget
+/// \return transform from frame pixel coordinates to widget coordinates, with the frame centered in the widget
+///
+QTransform CanvasView::frameToWidget() const
+{
+    double scale = fitScale();
+    QTransform transform;
+    transform.translate((width() - composite.width() * scale) / 2, (height() - composite.height() * scale) / 2);
+    transform.scale(scale, scale);
+    return transform;
+}
@@ -0,0 +1,44 @@
+#ifndef CANVASVIEW_H
+#define CANVASVIEW_H
+
+#include <QImage>
+#include <QPixmap>
+#include <QTransform>
+#include <QWidget>
+
+///
+/// \brief The CanvasView class shows the frame being edited. It keeps the frame composited over its background
+///        (and under the onion skin) plus an upscaled copy of that, and when the frame changes only the
+///        changed rectangle of each is rebuilt, so a small brush stroke costs a small redraw.
+///
+class CanvasView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit CanvasView(QWidget *parent = nullptr);
+
+    void showFrame(const QImage &canvas, const QImage &onionSkin = QImage());
+    void updateRect(const QRect &dirty, const QImage &canvas, const QImage &onionSkin = QImage());
+
+    QPoint pixelAt(const QPoint &pos) const;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    // the frame over a white background, with the onion skin over it; same size as the frame
+    QImage composite;
+    // composite scaled up by a whole number so that each frame pixel is an exact square
+    QPixmap upscaled;
+    int pixelScale = 1;
+
+    void composeRect(const QRect &rect, const QImage &canvas, const QImage &onionSkin);
+    void upscaleRect(const QRect &rect);
+    void rebuildUpscaled();
+    double fitScale() const;
+    QTransform frameToWidget() const;
+};
+
+#endif // CANVASVIEW_H
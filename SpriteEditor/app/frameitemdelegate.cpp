@@ -6,8 +6,10 @@
 
 ///
 /// \brief FrameItemDelegate::FrameItemDelegate constructor.
+/// \param thumbnails where frame thumbnails come from; must outlive the delegate
 ///
-FrameItemDelegate::FrameItemDelegate()
+FrameItemDelegate::FrameItemDelegate(ThumbnailCache *thumbnails)
+    : thumbnails(thumbnails)
 {
 
 }
@@ -51,12 +53,22 @@ void FrameItemDelegate::paint(QPainter *painter,
         painter->setPen(QPen(option.palette.windowText(), 1));
         painter->setBrush(Qt::NoBrush);
 
-        painter->drawRect(option.rect.marginsRemoved(QMargins(5, 5, 5, 20)));
+        QRect thumbnailRect = option.rect.marginsRemoved(QMargins(5, 5, 5, 20));
+        painter->drawRect(thumbnailRect);
         painter->drawText(QRect(option.rect.x(), option.rect.y() + option.rect.height() - 15, option.rect.width(), 15),
                           Qt::AlignHCenter,
                           QString::fromStdString("Frame " + std::to_string(row)));
 
-        painter->drawImage(option.rect.marginsRemoved(QMargins(5, 5, 5, 20)), frame->canvas);
+        //The thumbnail is normally already thumbnailRect's size; it only needs scaling while a new one renders
+        QPixmap thumbnail = thumbnails->thumbnail(frame, thumbnailRect.size());
+        if (thumbnail.size() == thumbnailRect.size())
+        {
+            painter->drawPixmap(thumbnailRect.topLeft(), thumbnail);
+        }
+        else if (!thumbnail.isNull())
+        {
+            painter->drawPixmap(thumbnailRect, thumbnail);
+        }
         painter->restore();
     } else
     {
@@ -3,6 +3,7 @@
 #define FRAMEITEMDELEGATE_H
 
 #include <QStyledItemDelegate>
+#include "thumbnailcache.h"
 
 ///
 /// \brief The FrameItemDelegate class is a helper for displaying frames in QListView
@@ -14,9 +15,12 @@ class FrameItemDelegate
     Q_OBJECT
 
 public:
-    FrameItemDelegate();
+    FrameItemDelegate(ThumbnailCache *thumbnails);
     QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const;
     void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+private:
+    ThumbnailCache *thumbnails;
 };
 
 #endif // FRAMEITEMDELEGATE_H
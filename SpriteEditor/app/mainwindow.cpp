@@ -0,0 +1,680 @@
+// Code style reviewed by Kyle Holland on 4/5/2023
+#include "mainwindow.h"
+#include "ui_mainwindow.h"
+
+#include "frameitemdelegate.h"
+#include <QColorDialog>
+#include <QComboBox>
+#include <QDialogButtonBox>
+#include <QFileDialog>
+#include <QFormLayout>
+#include <QInputDialog>
+#include <QLocale>
+#include <QMessageBox>
+#include <QScreen>
+#include <QSpinBox>
+
+///
+/// \brief MainWindow::MainWindow root window for the sprite editor
+/// \param _model reference to the Model containing editor state and supporting code
+/// \param parent used by Qt
+///
+MainWindow::MainWindow(std::shared_ptr<Model> _model, QWidget *parent)
+    : QMainWindow(parent),
+      ui(new Ui::MainWindow),
+      model(_model),
+      animationPreview(_model)
+{
+    ui->setupUi(this);
+    redrawScheduler.setInterval(refreshInterval());
+    connect(&redrawScheduler,
+            &RedrawScheduler::redrawAll,
+            this,
+            &MainWindow::drawCurrentFrame);
+    connect(&redrawScheduler,
+            &RedrawScheduler::redrawRect,
+            this,
+            &MainWindow::drawCurrentFrameRect);
+    redrawScheduler.requestFullRedraw();
+
+    ui->brushSelector->setCheckable(true);
+    ui->onionSkinningSelector->setCheckable(true);
+    ui->ditherSelector->setCheckable(true);
+    ui->paintBucketSelector->setCheckable(true);
+    ui->eraserSelector->setCheckable(true);
+
+    ui->deleteFrameButton->setDisabled(true);
+
+    connect(ui->brushSelector,
+            &QPushButton::clicked,
+            this,
+            &MainWindow::setBrushToggledState);
+
+    connect(ui->brushSelector,
+            &QPushButton::clicked,
+            _model.get(),
+            &Model::brushSelectedState);
+
+    connect(ui->onionSkinningSelector,
+            &QPushButton::clicked,
+            this,
+            &MainWindow::setOnionSkinningToggledState);
+
+    connect(ui->onionSkinningSelector,
+            &QPushButton::clicked,
+            _model.get(),
+            &Model::onionSkinningSelectedState);
+
+    //The view only redraws what changes, so show or hide the onion skin right away
+    connect(ui->onionSkinningSelector,
+            &QPushButton::clicked,
+            &redrawScheduler,
+            &RedrawScheduler::requestFullRedraw);
+
+    connect(ui->paintBucketSelector,
+            &QPushButton::clicked,
+            this,
+            &MainWindow::setPaintBucketToggledState);
+
+    connect(ui->paintBucketSelector,
+            &QPushButton::clicked,
+            _model.get(),
+            &Model::paintBucketSelectedState);
+
+    connect(ui->eraserSelector,
+            &QPushButton::clicked,
+            this,
+            &MainWindow::setEraserToggledState);
+
+    connect(ui->eraserSelector,
+            &QPushButton::clicked,
+            _model.get(),
+            &Model::eraserSelectedState);
+
+    connect(ui->ditherSelector,
+            &QPushButton::clicked,
+            this,
+            &MainWindow::setDithererToggledState);
+
+    connect(ui->ditherSelector,
+            &QPushButton::clicked,
+            _model.get(),
+            &Model::dithererSelectedState);
+
+    // Solid is what turning dithering off gives, and Custom is only set from code
+    for(int type = (int)DitherPattern::Type::Bayer2x2; type <= (int)DitherPattern::Type::Bayer8x8; type++)
+    {
+        ui->ditherPatternSelector->addItem(DitherPattern::typeNames()[type], type);
+    }
+
+    connect(ui->ditherPatternSelector,
+            QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this,
+            [this](int index)
+            {
+                model->ditherPatternChanged(ui->ditherPatternSelector->itemData(index).toInt());
+            });
+
+    connect(ui->ditherPercentSpinBox,
+            QOverload<int>::of(&QSpinBox::valueChanged),
+            _model.get(),
+            &Model::ditherPercentChanged);
+
+    ui->BrushSizeSpinBox->setRange(1, 5);
+
+    showColorOnButton(model->paintSettings.getPrimaryColor(), ui->primaryColor);
+    connect(ui->primaryColor,
+            &QPushButton::clicked,
+            this,
+            &MainWindow::primaryColorClicked);
+
+    showColorOnButton(model->paintSettings.getSecondaryColor(), ui->secondaryColor);
+    connect(ui->secondaryColor,
+            &QPushButton::clicked,
+            this,
+            &MainWindow::secondaryColorClicked);
+
+    connect(ui->BrushSizeSpinBox,
+            QOverload<int>::of(&QSpinBox::valueChanged),
+            _model.get(),
+            &Model::brushSizeValueChanged);
+
+    ui->actionSave->setShortcut(QKeySequence::Save);
+    connect(ui->actionSave,
+            &QAction::triggered,
+            this,
+            &MainWindow::save);
+
+    ui->actionSaveAs->setShortcut(QKeySequence::SaveAs);
+    connect(ui->actionSaveAs,
+            &QAction::triggered,
+            this,
+            &MainWindow::saveAs);
+
+    ui->actionLoad->setShortcut(QKeySequence::Open);
+    connect(ui->actionLoad,
+            &QAction::triggered,
+            this,
+            &MainWindow::load);
+
+    connect(ui->actionExportSpriteSheet,
+            &QAction::triggered,
+            this,
+            &MainWindow::exportSpriteSheet);
+
+    connect(ui->actionAutosaveInterval,
+            &QAction::triggered,
+            this,
+            &MainWindow::changeAutosaveInterval);
+
+    ui->action_Undo->setShortcut(QKeySequence::Undo);
+    connect(ui->action_Undo,
+            &QAction::triggered,
+            _model.get(),
+            &Model::undo);
+    connect(_model.get(),
+            &Model::updateUndoDisabled,
+            ui->action_Undo,
+            &QAction::setDisabled);
+    ui->action_Undo->setDisabled(model->getUndoDisabled());
+
+    ui->action_Redo->setShortcut(QKeySequence::Redo);
+    connect(ui->action_Redo,
+            &QAction::triggered,
+            _model.get(),
+            &Model::redo);
+    connect(_model.get(),
+            &Model::updateRedoDisabled,
+            ui->action_Redo,
+            &QAction::setDisabled);
+    ui->action_Redo->setDisabled(model->getRedoDisabled());
+
+    undoMemoryLabel = new QLabel(this);
+    ui->statusbar->addPermanentWidget(undoMemoryLabel);
+    connect(_model.get(),
+            &Model::undoMemoryUsageChanged,
+            this,
+            &MainWindow::showUndoMemoryUsage);
+    showUndoMemoryUsage(model->getUndoMemoryUsage());
+
+    redrawCountLabel = new QLabel(this);
+    ui->statusbar->addPermanentWidget(redrawCountLabel);
+    connect(&redrawScheduler,
+            &RedrawScheduler::countersChanged,
+            this,
+            &MainWindow::showRedrawCounts);
+    showRedrawCounts(redrawScheduler.getRequestedCount(), redrawScheduler.getExecutedCount());
+
+    //Mouse Event Connections
+    connect(this,
+            &MainWindow::mouseClicked,
+            _model.get(),
+            &Model::mouseClicked);
+
+    connect(this,
+            &MainWindow::mouseMoved,
+            _model.get(),
+            &Model::mouseMoved);
+
+    pathFlushTimer.setSingleShot(true);
+    connect(&pathFlushTimer,
+            &QTimer::timeout,
+            this,
+            &MainWindow::flushPendingPath);
+
+    connect(this,
+            &MainWindow::mouseReleased,
+            _model.get(),
+            &Model::mouseReleased);
+
+    connect(ui->confirmDimensionsButton,
+            &QDialogButtonBox::accepted,
+            this,
+            &MainWindow::changeFrameDimensions);
+    //connect QVector of frames to QListView
+    ui->frameList->setModel(&model->sprite);
+    ui->frameList->setItemDelegate(new FrameItemDelegate(&thumbnailCache));
+    //Only repaint the row whose thumbnail changed, not the whole list, since this happens for every dab
+    connect(&thumbnailCache,
+            &ThumbnailCache::thumbnailChanged,
+            this,
+            [this](const Frame *frame)
+            {
+                int row = model->sprite.rowOf(frame);
+                if(row >= 0)
+                    ui->frameList->update(model->sprite.index(row, 0));
+            });
+    //set framslist can drag their elements
+    ui->frameList->setSelectionMode(QAbstractItemView::SingleSelection);
+    ui->frameList->setDragEnabled(true);
+    ui->frameList->setAcceptDrops(true);
+    ui->frameList->setDropIndicatorShown(true);
+    ui->frameList->setDragDropMode(QAbstractItemView::DragDropMode::InternalMove);
+
+    connect(&model->sprite,
+            &Animation::drawFrame,
+            this,
+            &MainWindow::selectFrame);
+
+    model->sprite.changeFrame(0);
+
+    connect(ui->addFrameButton,
+            &QPushButton::clicked,
+            _model.get(),
+            &Model::addFrameToList);
+
+    ui->deleteFrameButton->setDisabled(true);
+
+    connect(ui->deleteFrameButton,
+            &QPushButton::clicked,
+            _model.get(),
+            &Model::deleteFrameFromList);
+
+    connect(&model->sprite, &Animation::disableDeleteButton,
+            ui->deleteFrameButton,
+            &QPushButton::setDisabled);
+
+    connect(ui->frameList, &QListView::clicked,
+            _model.get(),
+            //change big frame based on preview frame clicked
+            &Model::frameClicked);
+
+    //when button of copy frame is clicked, invoke copyFrame method
+    connect(ui->copyFrame, &QPushButton::clicked,
+            _model.get(),
+            &Model::copyFrame);
+
+    connect(_model.get(),
+            &Model::showWarning,
+            this,
+            &MainWindow::showWarning);
+
+    connect(_model.get(),
+            &Model::showStatus,
+            this,
+            &MainWindow::showStatus);
+
+    ui->animationPreviewButton->setDisabled(true);
+
+    connect(&model->sprite,
+            &Animation::setStateofAnimationPreview,
+            ui->animationPreviewButton,
+            &QPushButton::setDisabled);
+
+    connect(ui->animationPreviewButton,
+            &QPushButton::clicked,
+            _model.get(),
+            &Model::setStartingAnimationFrame);
+}
+
+///
+/// \brief MainWindow::~MainWindow destructor.
+///
+MainWindow::~MainWindow()
+{
+    delete ui;
+}
+
+///
+/// \brief MainWindow::drawCurrentFrame Draws the current frame with all settings
+///
+void MainWindow::drawCurrentFrame()
+{
+    ui->canvasView->showFrame(model->sprite.getCurFrame()->canvas, onionSkin());
+}
+
+///
+/// \brief MainWindow::drawCurrentFrameRect Redraws only the part of the current frame that changed
+/// \param dirty area of the frame that changed
+///
+void MainWindow::drawCurrentFrameRect(const QRect &dirty)
+{
+    ui->canvasView->updateRect(dirty, model->sprite.getCurFrame()->canvas, onionSkin());
+}
+
+///
+/// \brief MainWindow::onionSkin
+/// \return the canvas to show partially transparent over the current frame, or a null image if onion skinning is off
+///
+QImage MainWindow::onionSkin()
+{
+    //If onion skinning selected, draw partially transparent previous frame on screen.
+    if (model->getOnionSkinningSelected())
+    {
+        return model->sprite.getPrevFrame()->canvas;
+    }
+    return QImage();
+}
+
+///
+/// \brief MainWindow::selectFrame slot run when a different frame is selected
+/// \param currFrame the frame that is now selected
+///
+void MainWindow::selectFrame(std::shared_ptr<Frame> currFrame)
+{
+    //draws frame clicked at the bottom, then keeps drawing it as it changes
+    redrawScheduler.watchFrame(currFrame);
+    redrawScheduler.requestFullRedraw();
+}
+
+///
+/// \brief MainWindow::mousePressEvent Event that is fired when the mouse is clicked on the frame
+/// \param event - the mouse position
+///
+void MainWindow::mousePressEvent(QMouseEvent *event)
+{
+    flushPendingPath();
+    QPoint viewPos = ui->canvasView->mapFrom(this, event->pos());
+    if(ui->canvasView->rect().contains(viewPos))
+    {
+        QPoint pixel = ui->canvasView->pixelAt(viewPos);
+        int pixelX = pixel.x();
+        int pixelY = pixel.y();
+        prevX = pixelX;
+        prevY = pixelY;
+        emit mouseClicked(pixelX, pixelY);
+    }
+}
+
+///
+/// \brief MainWindow::mouseMoveEvent The event that is fired when the mouse is moved
+/// \param event - the mouse position
+///
+void MainWindow::mouseMoveEvent(QMouseEvent *event)
+{
+    QPoint viewPos = ui->canvasView->mapFrom(this, event->pos());
+    if(ui->canvasView->rect().contains(viewPos))
+    {
+        QPoint pixel = ui->canvasView->pixelAt(viewPos);
+        int pixelX = pixel.x();
+        int pixelY = pixel.y();
+        if(pixelX == prevX && pixelY == prevY)
+        {
+            return;
+        }
+        if(pendingPath.isEmpty())
+        {
+            pendingPath << QPoint(prevX, prevY);
+        }
+        pendingPath << QPoint(pixelX, pixelY);
+        prevX = pixelX;
+        prevY = pixelY;
+
+        //Draw what has built up once per display refresh instead of once per move event
+        if(!pathFlushTimer.isActive())
+        {
+            pathFlushTimer.start(refreshInterval());
+        }
+    }
+}
+
+///
+/// \brief MainWindow::flushPendingPath send every mouse position collected since the last flush to the model
+///
+void MainWindow::flushPendingPath()
+{
+    pathFlushTimer.stop();
+    if(pendingPath.isEmpty())
+    {
+        return;
+    }
+    QPolygon path;
+    path.swap(pendingPath);
+    emit mouseMoved(path);
+}
+
+///
+/// \brief MainWindow::mouseReleaseEvent The event that is fired when the mouse is released, ending the stroke
+/// \param event - unused
+///
+void MainWindow::mouseReleaseEvent(QMouseEvent *event)
+{
+    Q_UNUSED(event);
+    //The stroke isn't finished until every point has been drawn
+    flushPendingPath();
+    emit mouseReleased();
+}
+
+///
+/// \brief MainWindow::changeFrameDimensions changes the frames dimensions
+///
+void MainWindow::changeFrameDimensions()
+{
+    model->sprite.changeFrameDimensions(ui->frameDimensionWidth->value(), ui->frameDimensionHeight->value());
+    redrawScheduler.requestFullRedraw();
+}
+
+///
+/// \brief MainWindow::save save to the sprite's file, asking for one if it doesn't have one yet
+///
+void MainWindow::save()
+{
+    if(model->getCurrentFile() == tr(""))
+    {
+        saveAs();
+        return;
+    }
+    model->save();
+}
+
+///
+/// \brief MainWindow::saveAs open file picker and save to the file picked
+///
+void MainWindow::saveAs()
+{
+    Model::FileFormat format = Model::FileFormat::Binary;
+    QString filename = pickSaveLocation("Save sprite as...", format);
+    if(filename == tr("")) // user cancelled
+        return;
+    model->saveAs(filename, format);
+}
+
+///
+/// \brief MainWindow::load open file picker and load the file picked
+///
+void MainWindow::load()
+{
+    QString filename = QFileDialog::getOpenFileName(this, "Open sprite...", QString(), tr("Sprite files (*.ssp)"));
+    if(filename == tr("")) // user cancelled
+        return;
+    model->load(filename);
+}
+
+///
+/// \brief MainWindow::exportSpriteSheet ask the user how to lay out a sprite sheet and where to put it, then export it
+///
+void MainWindow::exportSpriteSheet()
+{
+    QDialog dialog(this);
+    dialog.setWindowTitle("Export Sprite Sheet");
+    QFormLayout *form = new QFormLayout(&dialog);
+
+    QSpinBox *columns = new QSpinBox(&dialog);
+    columns->setRange(0, 1000);
+    columns->setSpecialValueText("Automatic");
+    form->addRow("Columns:", columns);
+
+    QSpinBox *rows = new QSpinBox(&dialog);
+    rows->setRange(0, 1000);
+    rows->setSpecialValueText("Automatic");
+    form->addRow("Rows (if columns are automatic):", rows);
+
+    QSpinBox *padding = new QSpinBox(&dialog);
+    padding->setRange(0, 64);
+    padding->setSuffix(" px");
+    form->addRow("Padding:", padding);
+
+    QComboBox *metadata = new QComboBox(&dialog);
+    metadata->addItem("None", (int)SpriteSheet::Metadata::None);
+    metadata->addItem("JSON", (int)SpriteSheet::Metadata::Json);
+    metadata->addItem("XML", (int)SpriteSheet::Metadata::Xml);
+    form->addRow("Frame metadata:", metadata);
+
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog);
+    connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    form->addRow(buttons);
+
+    if(dialog.exec() != QDialog::Accepted)
+        return;
+
+    QString filename = QFileDialog::getSaveFileName(this, "Export sprite sheet...", QString(), tr("PNG images (*.png)"));
+    if(filename == tr("")) // user cancelled
+        return;
+
+    SpriteSheet::Options options;
+    options.columns = columns->value();
+    options.rows = rows->value();
+    options.padding = padding->value();
+    options.metadata = (SpriteSheet::Metadata)metadata->currentData().toInt();
+    model->exportSpriteSheet(filename, options);
+}
+
+///
+/// \brief MainWindow::pickSaveLocation helper method to open a file picker
+/// \param caption title of the file picker window
+/// \param format set to the format picked in the file picker; binary unless the JSON filter is chosen
+/// \return selected file name or tr("") if cancelled
+///
+QString MainWindow::pickSaveLocation(const QString& caption, Model::FileFormat &format)
+{
+    QString binaryFilter = tr("Sprite files (*.ssp)");
+    QString jsonFilter = tr("Sprite files, older JSON format (*.ssp)");
+    QString selectedFilter = binaryFilter;
+    QString filename = QFileDialog::getSaveFileName(this, caption, QString(), binaryFilter + ";;" + jsonFilter, &selectedFilter);
+    format = selectedFilter == jsonFilter ? Model::FileFormat::LegacyJson : Model::FileFormat::Binary;
+    return filename;
+}
+
+///
+/// \brief MainWindow::changeAutosaveInterval ask the user how often to autosave
+///
+void MainWindow::changeAutosaveInterval()
+{
+    bool ok;
+    int minutes = QInputDialog::getInt(this, "Autosave", "Minutes between autosaves (0 turns autosave off):",
+                                       model->getAutosaveInterval(), 0, 120, 1, &ok);
+    if(ok)
+        model->setAutosaveInterval(minutes);
+}
+
+// resize frame display when window is resized
+void MainWindow::resizeEvent(QResizeEvent *event)
+{
+    Q_UNUSED(event);
+    emit windowResized();
+}
+
+// turn off all the tool buttons visually
+void MainWindow::clearToolToggles()
+{
+    ui->brushSelector->setChecked(false);
+    ui->paintBucketSelector->setChecked(false);
+    ui->eraserSelector->setChecked(false);
+}
+
+// slot to select the brush tool visually
+void MainWindow::setBrushToggledState(bool clicked)
+{
+    clearToolToggles();
+    ui->brushSelector->setChecked(clicked);
+}
+
+// slot to toggle onion skinning visually
+void MainWindow::setOnionSkinningToggledState(bool clicked)
+{
+    ui->onionSkinningSelector->setChecked(clicked);
+}
+
+// slot to select the paint bucket tool visually
+void MainWindow::setPaintBucketToggledState(bool clicked)
+{
+    clearToolToggles();
+    ui->paintBucketSelector->setChecked(clicked);
+}
+
+// slot to select the eraser tool visually
+void MainWindow::setEraserToggledState(bool clicked)
+{
+    clearToolToggles();
+    ui->eraserSelector->setChecked(clicked);
+}
+
+// slot to toggle the dithering feature visually
+void MainWindow::setDithererToggledState(bool clicked)
+{
+    ui->ditherSelector->setChecked(clicked);
+}
+
+// open color picker and change the primary color
+void MainWindow::primaryColorClicked()
+{
+    QColor primary = QColorDialog::getColor();
+    model->paintSettings.setPrimaryColor(primary);
+    showColorOnButton(primary, ui->primaryColor);
+}
+
+// open color picker and change secondary color
+void MainWindow::secondaryColorClicked()
+{
+    QColor secondary = QColorDialog::getColor();
+    model->paintSettings.setSecondaryColor(secondary);
+    showColorOnButton(secondary, ui->secondaryColor);
+}
+
+// helper to change the color of a QPushButton
+void MainWindow::showColorOnButton(const QColor &color, QPushButton *button)
+{
+    // https://stackoverflow.com/a/15081186
+    QString s("background: #"
+          + QString(color.red() < 16? "0" : "") + QString::number(color.red(),16)
+          + QString(color.green() < 16? "0" : "") + QString::number(color.green(),16)
+          + QString(color.blue() < 16? "0" : "") + QString::number(color.blue(),16) + ";");
+    button->setStyleSheet(s);
+    button->update();
+}
+
+// helper to show a warning message box
+void MainWindow::showWarning(const QString& title, const QString& text)
+{
+    QMessageBox::warning(this, title, text);
+}
+
+// helper to show a short-lived message in the status bar
+void MainWindow::showStatus(const QString& text)
+{
+    ui->statusbar->showMessage(text, 5000);
+}
+
+// show how much memory the undo history is using
+void MainWindow::showUndoMemoryUsage(qint64 bytes)
+{
+    undoMemoryLabel->setText("Undo memory: " + QLocale().formattedDataSize(bytes));
+}
+
+///
+/// \brief MainWindow::showRedrawCounts show how many canvas redraws were asked for and how many were done
+/// \param requested redraws asked for
+/// \param executed redraws done
+///
+void MainWindow::showRedrawCounts(quint64 requested, quint64 executed)
+{
+    redrawCountLabel->setText(QString("Redraws: %1 of %2").arg(executed).arg(requested));
+}
+
+///
+/// \brief MainWindow::refreshInterval
+/// \return milliseconds per refresh of the display the window is on
+///
+int MainWindow::refreshInterval()
+{
+    qreal refreshRate = screen() ? screen()->refreshRate() : 60;
+    return qMax(1, qRound(1000 / qMax(refreshRate, (qreal)1)));
+}
+
+// show animation preview window
+void MainWindow::on_animationPreviewButton_clicked()
+{
+    animationPreview.setModal(true);
+    animationPreview.exec();
+}
@@ -4,8 +4,12 @@
 
 #include "animationpreview.h"
 #include "model.h"
+#include "redrawscheduler.h"
+#include "thumbnailcache.h"
+#include <QLabel>
 #include <QMainWindow>
 #include <QMouseEvent>
+#include <QPolygon>
 #include <QPushButton>
 #include <QTimer>
 
@@ -35,17 +39,28 @@ public slots:
     void setPaintBucketToggledState(bool clicked);
     void setEraserToggledState(bool clicked);
     void drawCurrentFrame();
+    void drawCurrentFrameRect(const QRect &dirty);
     void selectFrame(std::shared_ptr<Frame> currFrame);
 
     void primaryColorClicked();
     void secondaryColorClicked();
     void changeFrameDimensions();
+    void changeAutosaveInterval();
+
+    void save();
+    void saveAs();
+    void load();
+    void exportSpriteSheet();
 
     void showWarning(const QString& title, const QString& text);
+    void showStatus(const QString& text);
+    void showUndoMemoryUsage(qint64 bytes);
+    void showRedrawCounts(quint64 requested, quint64 executed);
 
 signals:
     void mouseClicked(int pixelX, int pixelY);
-    void mouseMoved(int pixelX, int pixelY, int prevX, int prevY);
+    void mouseMoved(const QPolygon &path);
+    void mouseReleased();
     void windowResized();
 
 private slots:
@@ -54,13 +69,25 @@ private slots:
 private:
     int prevX;
     int prevY;
+    // mouse positions not yet sent to the model; flushed at most once per display refresh
+    QPolygon pendingPath;
+    QTimer pathFlushTimer;
+    void flushPendingPath();
     Ui::MainWindow *ui;
     std::shared_ptr<Model> model;
     void mouseMoveEvent(QMouseEvent *event);
     void mousePressEvent(QMouseEvent *event);
+    void mouseReleaseEvent(QMouseEvent *event);
     void resizeEvent(QResizeEvent *event);
     AnimationPreview animationPreview;
+    QLabel *undoMemoryLabel;
+    QLabel *redrawCountLabel;
+    RedrawScheduler redrawScheduler;
+    ThumbnailCache thumbnailCache;
+    int refreshInterval();
+    QImage onionSkin();
     void showColorOnButton(const QColor &color, QPushButton *button);
+    QString pickSaveLocation(const QString& caption, Model::FileFormat &format);
 
     void clearToolToggles();
 };
@@ -0,0 +1,112 @@
+#include "redrawscheduler.h"
+#include <algorithm>
+
+// tick used until setInterval is called; about one refresh of a 60Hz display
+static const int DEFAULT_INTERVAL = 16;
+
+///
+/// \brief RedrawScheduler::RedrawScheduler constructor.
+/// \param parent used by Qt
+///
+RedrawScheduler::RedrawScheduler(QObject *parent)
+    : QObject(parent)
+{
+    tick.setSingleShot(true);
+    tick.setInterval(DEFAULT_INTERVAL);
+    connect(&tick, &QTimer::timeout, this, &RedrawScheduler::execute);
+}
+
+///
+/// \brief RedrawScheduler::watchFrame redraw whatever part of this frame changes, and stop watching the previous one
+/// \param frame the frame being shown
+///
+void RedrawScheduler::watchFrame(const std::shared_ptr<Frame> &frame)
+{
+    disconnect(frameConnection);
+    frameConnection = connect(frame.get(), &Frame::canvasChanged, this, &RedrawScheduler::requestRedraw);
+}
+
+///
+/// \brief RedrawScheduler::setInterval set the shortest time between two redraws
+/// \param milliseconds normally the length of one display refresh
+///
+void RedrawScheduler::setInterval(int milliseconds)
+{
+    tick.setInterval(std::max(milliseconds, 1));
+}
+
+///
+/// \brief RedrawScheduler::getRequestedCount
+/// \return how many redraws have been asked for
+///
+quint64 RedrawScheduler::getRequestedCount() const
+{
+    return requested;
+}
+
+///
+/// \brief RedrawScheduler::getExecutedCount
+/// \return how many redraws have actually been done
+///
+quint64 RedrawScheduler::getExecutedCount() const
+{
+    return executed;
+}
+
+///
+/// \brief RedrawScheduler::requestRedraw ask for part of the frame to be redrawn on the next tick
+/// \param dirty area of the frame that changed
+///
+void RedrawScheduler::requestRedraw(const QRect &dirty)
+{
+    pendingRect = pendingRect.united(dirty);
+    schedule();
+}
+
+///
+/// \brief RedrawScheduler::requestFullRedraw ask for the whole view to be redrawn on the next tick
+///
+void RedrawScheduler::requestFullRedraw()
+{
+    fullRedrawPending = true;
+    schedule();
+}
+
+///
+/// \brief RedrawScheduler::schedule count a request and make sure a tick is coming
+///
+void RedrawScheduler::schedule()
+{
+    requested++;
+    if (!tick.isActive())
+    {
+        tick.start();
+    }
+    emit countersChanged(requested, executed);
+}
+
+///
+/// \brief RedrawScheduler::execute carry out everything requested since the last tick as one redraw
+///
+void RedrawScheduler::execute()
+{
+    bool full = fullRedrawPending;
+    QRect dirty = pendingRect;
+    fullRedrawPending = false;
+    pendingRect = QRect();
+    if (!full && dirty.isEmpty())
+    {
+        return;
+    }
+
+    executed++;
+    if (full)
+    {
+        emit redrawAll();
+    }
+    else
+    {
+        emit redrawRect(dirty);
+    }
+    emit countersChanged(requested, executed);
+}
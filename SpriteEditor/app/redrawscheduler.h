@@ -0,0 +1,53 @@
+#ifndef REDRAWSCHEDULER_H
+#define REDRAWSCHEDULER_H
+
+#include "frame.h"
+#include <memory>
+#include <QObject>
+#include <QRect>
+#include <QTimer>
+
+///
+/// \brief The RedrawScheduler class collects requests to redraw the canvas view and carries them out at most
+///        once per tick (normally one display refresh). Requests made between ticks are merged into one dirty
+///        rectangle. It also holds the view's only subscription to the frame being edited.
+///
+class RedrawScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RedrawScheduler(QObject *parent = nullptr);
+
+    void watchFrame(const std::shared_ptr<Frame> &frame);
+    void setInterval(int milliseconds);
+
+    quint64 getRequestedCount() const;
+    quint64 getExecutedCount() const;
+
+public slots:
+    void requestRedraw(const QRect &dirty);
+    void requestFullRedraw();
+
+signals:
+    void redrawRect(const QRect &dirty);
+    void redrawAll();
+    void countersChanged(quint64 requested, quint64 executed);
+
+private slots:
+    void execute();
+
+private:
+    QMetaObject::Connection frameConnection;
+    QTimer tick;
+
+    QRect pendingRect;
+    bool fullRedrawPending = false;
+
+    quint64 requested = 0;
+    quint64 executed = 0;
+
+    void schedule();
+};
+
+#endif // REDRAWSCHEDULER_H
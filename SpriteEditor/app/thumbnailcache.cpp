@@ -0,0 +1,115 @@
+#include "thumbnailcache.h"
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+///
+/// \brief ThumbnailCache::ThumbnailCache constructor.
+/// \param parent used by Qt
+///
+ThumbnailCache::ThumbnailCache(QObject *parent)
+    : QObject(parent)
+{
+
+}
+
+///
+/// \brief ThumbnailCache::thumbnail get a frame's thumbnail, starting a new render if the cached one is stale
+/// \param frame the frame
+/// \param size size the thumbnail is drawn at
+/// \return the newest thumbnail rendered, which may be stale or a different size; null if none is ready yet
+///
+QPixmap ThumbnailCache::thumbnail(const std::shared_ptr<Frame> &frame, const QSize &size)
+{
+    Entry &entry = entryFor(frame.get());
+    bool stale = entry.pixmap.isNull() || entry.renderedGeneration != entry.generation || entry.size != size;
+    if (stale && !entry.rendering && !size.isEmpty())
+    {
+        startRender(frame.get(), entry, frame->canvas, size);
+    }
+    return entry.pixmap;
+}
+
+///
+/// \brief ThumbnailCache::entryFor find a frame's entry, making one that follows the frame's changes if needed
+/// \param frame the frame
+/// \return the entry
+///
+ThumbnailCache::Entry &ThumbnailCache::entryFor(Frame *frame)
+{
+    auto found = entries.find(frame);
+    if (found != entries.end())
+    {
+        return found->second;
+    }
+
+    Entry &entry = entries[frame];
+    connect(frame,
+            &Frame::canvasChanged,
+            this,
+            [this, frame]
+            {
+                entries[frame].generation++;
+                emit thumbnailChanged(frame);
+            });
+    connect(frame,
+            &QObject::destroyed,
+            this,
+            [this, frame]
+            {
+                entries.erase(frame);
+            });
+    //Start out stale so the first request renders
+    entry.generation = 1;
+    return entry;
+}
+
+///
+/// \brief ThumbnailCache::startRender scale a copy of the canvas down on a background thread
+/// \param frame the frame the thumbnail is for
+/// \param entry the frame's entry
+/// \param canvas the frame's canvas (implicitly shared, so edits to the frame don't affect the render)
+/// \param size size of the thumbnail
+///
+void ThumbnailCache::startRender(const Frame *frame, Entry &entry, const QImage &canvas, const QSize &size)
+{
+    entry.rendering = true;
+    quint64 generation = entry.generation;
+
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher,
+            &QFutureWatcher<QImage>::finished,
+            this,
+            [this, watcher, frame, generation, size]
+            {
+                finishRender(frame, generation, size, watcher->result());
+                watcher->deleteLater();
+            });
+    watcher->setFuture(QtConcurrent::run([canvas, size]
+    {
+        return canvas.scaled(size, Qt::IgnoreAspectRatio, Qt::FastTransformation);
+    }));
+}
+
+///
+/// \brief ThumbnailCache::finishRender install a rendered thumbnail, unless its frame is gone
+/// \param frame the frame the thumbnail is for
+/// \param generation the frame's generation when the render started
+/// \param size size of the thumbnail
+/// \param image the rendered thumbnail
+///
+void ThumbnailCache::finishRender(const Frame *frame, quint64 generation, const QSize &size, const QImage &image)
+{
+    auto found = entries.find(frame);
+    if (found == entries.end())
+    {
+        return;
+    }
+
+    Entry &entry = found->second;
+    entry.rendering = false;
+    //QPixmap has to be made on the GUI thread
+    entry.pixmap = QPixmap::fromImage(image);
+    entry.size = size;
+    entry.renderedGeneration = generation;
+    emit thumbnailChanged(frame);
+}
@@ -0,0 +1,46 @@
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include "frame.h"
+#include <memory>
+#include <QObject>
+#include <QPixmap>
+#include <QSize>
+#include <unordered_map>
+
+///
+/// \brief The ThumbnailCache class keeps a small copy of each frame at the size it is shown in the frame list.
+///        A thumbnail goes stale when its frame's canvas changes and is rendered again on a background thread
+///        the next time it is asked for; until then the stale one is returned.
+///
+class ThumbnailCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ThumbnailCache(QObject *parent = nullptr);
+
+    QPixmap thumbnail(const std::shared_ptr<Frame> &frame, const QSize &size);
+
+signals:
+    // a frame's thumbnail went stale or a new one is ready; views showing that frame should repaint it
+    void thumbnailChanged(const Frame *frame);
+
+private:
+    struct Entry
+    {
+        QPixmap pixmap;
+        QSize size;
+        // bumped every time the frame changes, so finished renders of an older canvas are recognized
+        quint64 generation = 0;
+        quint64 renderedGeneration = 0;
+        bool rendering = false;
+    };
+    std::unordered_map<const Frame*, Entry> entries;
+
+    Entry &entryFor(Frame *frame);
+    void startRender(const Frame *frame, Entry &entry, const QImage &canvas, const QSize &size);
+    void finishRender(const Frame *frame, quint64 generation, const QSize &size, const QImage &image);
+};
+
+#endif // THUMBNAILCACHE_H
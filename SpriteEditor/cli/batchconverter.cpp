@@ -0,0 +1,196 @@
+#include "batchconverter.h"
+#include "fileerror.h"
+#include "frame.h"
+#include "legacyspritefile.h"
+#include "spritefile.h"
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtConcurrent>
+
+///
+/// \brief elapsedMs read a timer
+/// \param timer started timer
+/// \return milliseconds since it was started
+///
+static double elapsedMs(const QElapsedTimer &timer)
+{
+    return timer.nsecsElapsed() / 1e6;
+}
+
+///
+/// \brief BatchConverter::BatchConverter constructor
+/// \param options what to do to each file
+///
+BatchConverter::BatchConverter(const BatchOptions &options)
+    : options(options)
+{
+
+}
+
+///
+/// \brief BatchConverter::load read a sprite file in either format, decoding every frame
+/// \param file file to read
+/// \param snapshot filled with the animation
+/// \param error set to a message for the user if reading fails
+/// \return true if read successfully
+///
+bool BatchConverter::load(const QString &file, AnimationSnapshot &snapshot, QString *error)
+{
+    QFile openFile(file);
+    if (!openFile.open(QIODevice::ReadOnly))
+    {
+        setError(error, openFile.errorString());
+        return false;
+    }
+    if (SpriteFile::isSpriteFile(&openFile))
+    {
+        return SpriteFile::read(&openFile, snapshot, error);
+    }
+    return LegacySpriteFile::read(&openFile, snapshot, error);
+}
+
+///
+/// \brief BatchConverter::process load one file and do everything asked for to it. Safe to call from any thread.
+/// \param file file to process
+/// \return what happened
+///
+BatchResult BatchConverter::process(const QString &file) const
+{
+    BatchResult result;
+    result.file = file;
+    QElapsedTimer total;
+    total.start();
+
+    QElapsedTimer step;
+    step.start();
+    AnimationSnapshot snapshot;
+    bool ok = load(file, snapshot, &result.error);
+    result.loadMs = elapsedMs(step);
+
+    if (ok && !options.resize.isEmpty() && options.resize != snapshot.frameSize)
+    {
+        step.start();
+        // scale the way the editor does, so the output matches resizing by hand
+        for (QImage &frame : snapshot.frames)
+        {
+            frame = Frame::scaledCanvas(frame, options.resize);
+        }
+        snapshot.frameSize = options.resize;
+        result.resizeMs = elapsedMs(step);
+    }
+
+    if (ok)
+    {
+        result.frameSize = snapshot.frameSize;
+        result.frameCount = snapshot.frames.size();
+        step.start();
+        ok = write(file, snapshot, &result.error);
+        result.writeMs = elapsedMs(step);
+    }
+
+    result.totalMs = elapsedMs(total);
+    return result;
+}
+
+///
+/// \brief BatchConverter::processAll process files on the thread pool, as many at once as it has threads
+/// \param files files to process
+/// \return what happened to each file, in the same order
+///
+QList<BatchResult> BatchConverter::processAll(const QStringList &files) const
+{
+    return QtConcurrent::blockingMapped<QList<BatchResult>>(files, [this](const QString &file)
+    {
+        return process(file);
+    });
+}
+
+///
+/// \brief BatchConverter::write write everything asked for from one file
+/// \param file the input file the outputs are named after
+/// \param snapshot the animation
+/// \param error set to a message for the user if writing fails
+/// \return true if written successfully
+///
+bool BatchConverter::write(const QString &file, const AnimationSnapshot &snapshot, QString *error) const
+{
+    if (options.convert != BatchOptions::Convert::None)
+    {
+        QString path = outputPath(file, ".ssp");
+        if (!options.inPlace && path == QDir::cleanPath(QFileInfo(file).absoluteFilePath()))
+        {
+            setError(error, "Converting would overwrite the file itself.");
+            return false;
+        }
+        QSaveFile saveFile(path);
+        if (!saveFile.open(QIODevice::WriteOnly))
+        {
+            setError(error, saveFile.errorString());
+            return false;
+        }
+        bool written = false;
+        switch (options.convert)
+        {
+            case BatchOptions::Convert::Binary:
+                written = SpriteFile::write(&saveFile, snapshot, error);
+                break;
+            case BatchOptions::Convert::Json:
+                written = LegacySpriteFile::write(&saveFile, snapshot, error);
+                break;
+            case BatchOptions::Convert::JsonArrays:
+                written = LegacySpriteFile::write(&saveFile, snapshot, error, LegacySpriteFile::RowEncoding::Arrays);
+                break;
+            case BatchOptions::Convert::None:
+                break;
+        }
+        if (!written)
+        {
+            return false;
+        }
+        if (!saveFile.commit())
+        {
+            setError(error, saveFile.errorString());
+            return false;
+        }
+    }
+
+    if (options.exportFrames)
+    {
+        int digits = QString::number(snapshot.frames.size() - 1).size();
+        for (size_t i = 0; i < snapshot.frames.size(); i++)
+        {
+            QString path = outputPath(file, QString("_%1.png").arg(i, digits, 10, QChar('0')));
+            if (!snapshot.frames[i].save(path, "PNG"))
+            {
+                setError(error, "Unable to write " + path + ".");
+                return false;
+            }
+        }
+    }
+
+    if (options.exportSheet)
+    {
+        QString path = outputPath(file, "_sheet.png");
+        if (!SpriteSheet::write(path, snapshot, options.sheetOptions, error))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+///
+/// \brief BatchConverter::outputPath name an output after its input file
+/// \param file the input file
+/// \param suffix what to put after the input's name, including the extension
+/// \return the output's absolute, clean path, in the output directory or else next to the input
+///
+QString BatchConverter::outputPath(const QString &file, const QString &suffix) const
+{
+    QFileInfo info(file);
+    QDir dir(options.outputDir.isEmpty() ? info.absolutePath() : options.outputDir);
+    return QDir::cleanPath(dir.absoluteFilePath(info.completeBaseName() + suffix));
+}
@@ -0,0 +1,70 @@
+#ifndef BATCHCONVERTER_H
+#define BATCHCONVERTER_H
+
+#include "animationsnapshot.h"
+#include "spritesheet.h"
+#include <QList>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+
+///
+/// \brief The BatchOptions struct says what BatchConverter does to each file
+///
+struct BatchOptions
+{
+    enum class Convert { None, Binary, Json, JsonArrays };
+
+    // write the sprite again as <name>.ssp in this format
+    Convert convert = Convert::None;
+    // let convert replace the input file when <name>.ssp is the input itself; otherwise that is an error
+    bool inPlace = false;
+    // write each frame as <name>_<frame>.png
+    bool exportFrames = false;
+    // write every frame on one image as <name>_sheet.png, laid out as sheetOptions says, with its metadata next to it
+    bool exportSheet = false;
+    SpriteSheet::Options sheetOptions;
+    // scale every frame to this size before writing anything; empty to keep the size
+    QSize resize;
+    // where to write; empty to write next to each input file
+    QString outputDir;
+};
+
+///
+/// \brief The BatchResult struct is what happened to one file. Times are in milliseconds.
+///
+struct BatchResult
+{
+    QString file;
+    // a message for the user, or empty if everything asked for was done
+    QString error;
+    QSize frameSize;
+    int frameCount = 0;
+    double loadMs = 0;
+    double resizeMs = 0;
+    double writeMs = 0;
+    double totalMs = 0;
+};
+
+///
+/// \brief The BatchConverter class loads sprite files and converts, resizes and exports them, many at once. With
+///        nothing to do it only loads each file, which checks it: every frame is decoded.
+///
+class BatchConverter
+{
+public:
+    explicit BatchConverter(const BatchOptions &options);
+
+    BatchResult process(const QString &file) const;
+    QList<BatchResult> processAll(const QStringList &files) const;
+
+    static bool load(const QString &file, AnimationSnapshot &snapshot, QString *error = nullptr);
+    QString outputPath(const QString &file, const QString &suffix) const;
+
+private:
+    bool write(const QString &file, const AnimationSnapshot &snapshot, QString *error) const;
+
+    BatchOptions options;
+};
+
+#endif // BATCHCONVERTER_H
@@ -0,0 +1,22 @@
+# Converts, exports and checks sprites without a display; see main.cpp for usage.
+TARGET = spiffysprites-cli
+
+QT       = core gui
+
+CONFIG += c++17
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../core/core.pri)
+
+SOURCES += \
+    batchconverter.cpp \
+    main.cpp
+
+HEADERS += \
+    batchconverter.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
@@ -0,0 +1,220 @@
+#include "batchconverter.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QTextStream>
+#include <QThreadPool>
+
+// exit codes
+static const int EXIT_OK = 0;
+static const int EXIT_FILE_FAILED = 1;
+static const int EXIT_USAGE = 2;
+
+///
+/// \brief resultToJson describe what happened to a file for --timing
+/// \param result what happened
+/// \return one line's object
+///
+static QJsonObject resultToJson(const BatchResult &result)
+{
+    QJsonObject json;
+    json["file"] = result.file;
+    json["ok"] = result.error.isEmpty();
+    if (!result.error.isEmpty())
+    {
+        json["error"] = result.error;
+    }
+    json["width"] = result.frameSize.width();
+    json["height"] = result.frameSize.height();
+    json["frames"] = result.frameCount;
+    json["loadMs"] = result.loadMs;
+    json["resizeMs"] = result.resizeMs;
+    json["writeMs"] = result.writeMs;
+    json["totalMs"] = result.totalMs;
+    return json;
+}
+
+///
+/// \brief main convert, resize, export or check sprite files without a display
+/// \param argc argument count, used by Qt
+/// \param argv arguments, used by Qt
+/// \return EXIT_OK if every file was processed, EXIT_FILE_FAILED if any wasn't, EXIT_USAGE if the arguments are wrong
+///
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("spiffysprites-cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Convert, resize, export or check SpiffySprites files. With no action, each file "
+                                     "is only loaded, which checks that every frame can be read.");
+    parser.addHelpOption();
+    QCommandLineOption convertOption("convert", "Write each sprite again as <name>.ssp, in <format>: binary, json, "
+                                     "or json-arrays (the JSON format older tools read). A file is never converted "
+                                     "over itself unless --in-place is given.", "format");
+    QCommandLineOption inPlaceOption("in-place", "Let --convert replace the input files.");
+    QCommandLineOption framesOption("frames", "Export each frame as <name>_<frame>.png.");
+    QCommandLineOption sheetOption("sheet", "Export every frame on one image as <name>_sheet.png.");
+    QCommandLineOption columnsOption("columns", "Frames per row of the sprite sheet (default: all in one row).", "n");
+    QCommandLineOption rowsOption("rows", "Rows of frames on the sprite sheet, if --columns isn't given.", "n");
+    QCommandLineOption paddingOption("padding", "Transparent pixels between sprite sheet frames and around the edge.",
+                                     "pixels");
+    QCommandLineOption metadataOption("metadata", "Also write the sprite sheet's frame rectangles as <name>_sheet.json "
+                                      "or <name>_sheet.xml, in <format>: json or xml.", "format");
+    QCommandLineOption resizeOption("resize", "Scale every frame to <width>x<height> before writing anything.", "size");
+    QCommandLineOption outputOption({"o", "output-dir"}, "Write to <dir> instead of next to each file.", "dir");
+    QCommandLineOption jobsOption({"j", "jobs"}, "Process <n> files at once (default: one per core).", "n");
+    QCommandLineOption timingOption("timing", "Print one JSON object per file, then a summary, instead of text.");
+    parser.addOptions({convertOption, inPlaceOption, framesOption, sheetOption, columnsOption, rowsOption, paddingOption, metadataOption,
+                       resizeOption, outputOption, jobsOption, timingOption});
+    parser.addPositionalArgument("files", "Sprite files (.ssp) to process.", "files...");
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    auto usageError = [&err](const QString &message)
+    {
+        err << "spiffysprites-cli: " << message << Qt::endl;
+        return EXIT_USAGE;
+    };
+
+    QStringList files = parser.positionalArguments();
+    if (files.isEmpty())
+    {
+        return usageError("no files given; see --help");
+    }
+
+    BatchOptions options;
+    if (parser.isSet(convertOption))
+    {
+        QString format = parser.value(convertOption);
+        if (format == "binary")
+            options.convert = BatchOptions::Convert::Binary;
+        else if (format == "json")
+            options.convert = BatchOptions::Convert::Json;
+        else if (format == "json-arrays")
+            options.convert = BatchOptions::Convert::JsonArrays;
+        else
+            return usageError("unknown format " + format);
+    }
+    options.inPlace = parser.isSet(inPlaceOption);
+    options.exportFrames = parser.isSet(framesOption);
+    options.exportSheet = parser.isSet(sheetOption);
+    if (parser.isSet(columnsOption))
+    {
+        bool ok;
+        options.sheetOptions.columns = parser.value(columnsOption).toInt(&ok);
+        if (!ok || options.sheetOptions.columns < 1)
+            return usageError("--columns takes a positive number");
+    }
+    if (parser.isSet(rowsOption))
+    {
+        bool ok;
+        options.sheetOptions.rows = parser.value(rowsOption).toInt(&ok);
+        if (!ok || options.sheetOptions.rows < 1)
+            return usageError("--rows takes a positive number");
+    }
+    if (parser.isSet(paddingOption))
+    {
+        bool ok;
+        options.sheetOptions.padding = parser.value(paddingOption).toInt(&ok);
+        if (!ok || options.sheetOptions.padding < 0)
+            return usageError("--padding takes a number of pixels");
+    }
+    if (parser.isSet(metadataOption))
+    {
+        QString format = parser.value(metadataOption);
+        if (format == "json")
+            options.sheetOptions.metadata = SpriteSheet::Metadata::Json;
+        else if (format == "xml")
+            options.sheetOptions.metadata = SpriteSheet::Metadata::Xml;
+        else
+            return usageError("unknown metadata format " + format);
+    }
+    if (parser.isSet(resizeOption))
+    {
+        QStringList size = parser.value(resizeOption).split('x');
+        bool widthOk = false;
+        bool heightOk = false;
+        if (size.size() == 2)
+            options.resize = QSize(size[0].toInt(&widthOk), size[1].toInt(&heightOk));
+        if (!widthOk || !heightOk || options.resize.isEmpty())
+            return usageError("--resize takes <width>x<height>, for example 64x64");
+    }
+    if (parser.isSet(outputOption))
+    {
+        options.outputDir = parser.value(outputOption);
+        if (!QDir().mkpath(options.outputDir))
+            return usageError("cannot create " + options.outputDir);
+    }
+    if (parser.isSet(jobsOption))
+    {
+        bool ok;
+        int jobs = parser.value(jobsOption).toInt(&ok);
+        if (!ok || jobs < 1)
+            return usageError("--jobs takes a positive number");
+        QThreadPool::globalInstance()->setMaxThreadCount(jobs);
+    }
+
+    // Outputs are named after their input, so check before starting that no two files are written at once by
+    // different threads, and that nothing overwrites an input without --in-place
+    BatchConverter converter(options);
+    if (options.convert != BatchOptions::Convert::None || options.exportFrames || options.exportSheet)
+    {
+        QSet<QString> inputs;
+        for (const QString &file : files)
+            inputs.insert(QDir::cleanPath(QFileInfo(file).absoluteFilePath()));
+
+        QHash<QString, QString> writers;
+        for (const QString &file : files)
+        {
+            QString outputs = converter.outputPath(file, QString());
+            auto other = writers.constFind(outputs);
+            if (other != writers.cend())
+                return usageError(*other + " and " + file + " would write the same output files; rename one, or "
+                                  "process them separately");
+            writers.insert(outputs, file);
+
+            QString converted = converter.outputPath(file, ".ssp");
+            if (options.convert != BatchOptions::Convert::None && !options.inPlace && inputs.contains(converted))
+                return usageError("--convert would overwrite " + QDir::toNativeSeparators(converted) + "; give "
+                                  "--output-dir to write elsewhere, or --in-place to replace it");
+        }
+    }
+
+    QElapsedTimer total;
+    total.start();
+    QList<BatchResult> results = converter.processAll(files);
+    double totalMs = total.nsecsElapsed() / 1e6;
+
+    int failed = 0;
+    for (const BatchResult &result : results)
+    {
+        if (!result.error.isEmpty())
+            failed++;
+
+        if (parser.isSet(timingOption))
+            out << QJsonDocument(resultToJson(result)).toJson(QJsonDocument::Compact) << '\n';
+        else if (result.error.isEmpty())
+            out << result.file << ": ok" << Qt::endl;
+        else
+            err << result.file << ": " << result.error << Qt::endl;
+    }
+
+    if (parser.isSet(timingOption))
+    {
+        QJsonObject summary;
+        summary["files"] = (int)results.size();
+        summary["failed"] = failed;
+        summary["jobs"] = QThreadPool::globalInstance()->maxThreadCount();
+        summary["totalMs"] = totalMs;
+        out << QJsonDocument(summary).toJson(QJsonDocument::Compact) << Qt::endl;
+    }
+    return failed == 0 ? EXIT_OK : EXIT_FILE_FAILED;
+}
@@ -27,17 +27,29 @@ Animation::Animation(QObject *parent, QSize frameSize)
 ///
 void Animation::replaceFrame(int targetLocation, std::shared_ptr<Frame> frame, bool pushUndo)
 {
-    beginResetModel();
-    std::shared_ptr old_frame = frames[targetLocation];
+    std::shared_ptr old_frame = loadedFrame(targetLocation);
     frames[targetLocation] = frame;
-    endResetModel();
-    drawFrame(frames[targetLocation]);
+    //Only this row's frame changed
+    emit dataChanged(index(targetLocation, 0), index(targetLocation, 0));
+    drawFrame(loadedFrame(targetLocation));
 
     linkCanvasChanged(frame);
     if(pushUndo)
         emit pushUndoState(UndoState::forFrameChange(targetLocation, old_frame, std::make_shared<Frame>(*frame)));
 }
 
+///
+/// \brief Animation::patchFrame overwrite part of a frame's canvas in place without pushing an undo state
+/// \param targetLocation index of the frame to patch
+/// \param region area of the canvas to overwrite
+/// \param pixels image the size of region holding the new pixels
+///
+void Animation::patchFrame(int targetLocation, const QRect &region, const QImage &pixels)
+{
+    loadedFrame(targetLocation)->restoreRegion(region, pixels);
+    emit dataChanged(index(targetLocation, 0), index(targetLocation, 0));
+}
+
 ///
 /// \brief Animation::insertFrame
 /// \param targetLocation
@@ -46,10 +58,10 @@ void Animation::replaceFrame(int targetLocation, std::shared_ptr<Frame> frame, b
 ///
 void Animation::insertFrame(int targetLocation, std::shared_ptr<Frame> frame, bool pushUndo)
 {
-    beginResetModel();
+    beginInsertRows(QModelIndex(), targetLocation, targetLocation);
     frames.insert(frames.begin() + targetLocation, frame);
-    endResetModel();
-     drawFrame(frames[targetLocation]);
+    endInsertRows();
+     drawFrame(loadedFrame(targetLocation));
 
     linkCanvasChanged(frame);
     if(pushUndo)
@@ -67,13 +79,13 @@ void Animation:: addFrame(QSize frameSize, bool pushUndo)
     int width = frameSize.width();
     //create a new frame that depends on the provided size
     std::shared_ptr<Frame> addedFrame = std::make_shared<Frame>(width, height);
-    beginResetModel();
+    beginInsertRows(QModelIndex(), (int)frames.size(), (int)frames.size());
     frames.push_back(addedFrame);
-    endResetModel();
+    endInsertRows();
     //add new frame to the tail of list
     currFrameIndex = frames.size() - 1;
     //automatically display just added frame on mainwindow
-    emit drawFrame(frames[currFrameIndex]);
+    emit drawFrame(loadedFrame(currFrameIndex));
     emit disableDeleteButton(false);
     emit setStateofAnimationPreview(false);
 
@@ -98,7 +110,7 @@ void Animation::setSpeed(double speed)
 void Animation::changeFrame(int targetLocation)
 {
     currFrameIndex = targetLocation;
-    emit drawFrame(frames[targetLocation]);
+    emit drawFrame(loadedFrame(targetLocation));
 }
 
 ///
@@ -117,7 +129,7 @@ void Animation::changeFrameDimensions(int width, int height)
 
 void Animation::changeFrameWhenAnimating(int frameIndex)
 {   currFrameIndex = frameIndex;
-    emit drawAnimationFrame(frames[frameIndex]);
+    emit drawAnimationFrame(loadedFrame(frameIndex));
 }
 
 ///
@@ -128,13 +140,13 @@ void Animation::changeFrameWhenAnimating(int frameIndex)
 void Animation::deleteFrame(int targetLocation, bool pushUndo)
 {
     //save selected frame to be deleted
-    std::shared_ptr<Frame> to_delete = frames[targetLocation];
+    std::shared_ptr<Frame> to_delete = loadedFrame(targetLocation);
     //if the index of selected frame is in a proper range of list's size while list has one than one frame, then delete selected frame
     if(targetLocation >= 0 && targetLocation < (int)frames.size() && frames.size() > 1)
     {
-        beginResetModel();
+        beginRemoveRows(QModelIndex(), targetLocation, targetLocation);
         frames.erase(frames.begin() + targetLocation);
-        endResetModel();
+        endRemoveRows();
     }
     //if the selected frame is the only frame in the list, then disable delete button
     if(currFrameIndex >= (int)frames.size())
@@ -147,7 +159,7 @@ void Animation::deleteFrame(int targetLocation, bool pushUndo)
 
             currFrameIndex = (int)frames.size() - 1;
     }
-    emit drawFrame(frames[currFrameIndex]);
+    emit drawFrame(loadedFrame(currFrameIndex));
 
     if(pushUndo)
         emit pushUndoState(UndoState::forFrameDelete(targetLocation, to_delete));
@@ -160,14 +172,14 @@ void Animation::deleteFrame(int targetLocation, bool pushUndo)
 ///
 void Animation::copyFrame(int targetLocation, bool pushUndo)
 {
-    beginResetModel();
     currFrameIndex = targetLocation + 1;
-    std::shared_ptr<Frame> newFrame = std::make_shared<Frame>(*frames[targetLocation]);
+    std::shared_ptr<Frame> newFrame = std::make_shared<Frame>(*loadedFrame(targetLocation));
     //create copied frame behind selected frame
+    beginInsertRows(QModelIndex(), targetLocation + 1, targetLocation + 1);
     frames.insert(frames.begin() + targetLocation + 1, newFrame);
-    endResetModel();
+    endInsertRows();
     //make mainwindow display the just copied frame
-    emit drawFrame(frames[currFrameIndex]);
+    emit drawFrame(loadedFrame(currFrameIndex));
     emit disableDeleteButton(false);
     emit setStateofAnimationPreview(false);
 
@@ -182,7 +194,7 @@ void Animation::copyFrame(int targetLocation, bool pushUndo)
 ///
 std::shared_ptr<Frame> Animation::getCurFrame()
 {
-    return frames[currFrameIndex];
+    return loadedFrame(currFrameIndex);
 }
 
 ///
@@ -192,102 +204,162 @@ std::shared_ptr<Frame> Animation::getCurFrame()
 std::shared_ptr<Frame> Animation::getPrevFrame()
 {
     if (currFrameIndex >= 1)
-        return frames[currFrameIndex-1];
+        return loadedFrame(currFrameIndex-1);
     else
-        return frames[currFrameIndex];
+        return loadedFrame(currFrameIndex);
 }
 
 ///
-/// \brief Animation::paintEvent event to be called to draw
-/// \param event event to be invoked
+/// \brief Animation::snapshot copy the pixel data of every frame. Cheap, since the canvases are implicitly shared.
+/// \param isStored if given, frames whose revision it returns true for are left out (as null images), and are
+///        not decoded if they were loaded lazily
+/// \param deferDecoding if true, lazily loaded frames that haven't been decoded yet are left to the snapshot's
+///        loaders instead of being decoded here, so that a background thread can do it; see
+///        AnimationSnapshot::decodeFrames
+/// \return the snapshot
 ///
-void Animation::paintEvent(QPaintEvent *event)
+AnimationSnapshot Animation::snapshot(const std::function<bool(quint64)> &isStored, bool deferDecoding) const
 {
-    Q_UNUSED(event);
+    AnimationSnapshot s;
+    s.frameSize = frameSize;
+    for(size_t i = 0; i < frames.size(); i++)
+    {
+        const std::shared_ptr<Frame> &f = frames[i];
+        s.revisions.push_back(f->getRevision());
+        if(isStored && isStored(f->getRevision()))
+        {
+            s.frames.push_back(QImage());
+            continue;
+        }
+        if(deferDecoding && !f->isLoaded())
+        {
+            s.loaders.resize(frames.size());
+            s.loaders[i] = f->getLoader();
+            s.frames.push_back(QImage());
+            continue;
+        }
+        f->ensureLoaded();
+        s.frames.push_back(f->canvas);
+    }
+    return s;
 }
 
 ///
-/// \brief Animation::toJson serialize the Animation to a Qt JSON object
-/// \return a QJsonObject containing keys height (int), width (int), numberOfFrames (int), and frames (object) [see Frame::toJson]
+/// \brief Animation::hasDamagedFrames
+/// \return true if a lazily loaded frame couldn't be decoded and hasn't been drawn on since (see Frame::isDamaged)
 ///
-QJsonObject Animation::toJson()
+bool Animation::hasDamagedFrames() const
 {
-    QJsonObject s;
-    s["height"] = frameSize.height();
-    s["width"] = frameSize.width();
-    s["numberOfFrames"] = (int)frames.size();
-
-    QJsonObject s_frames;
-    size_t frame_n = 0;
-    for(std::shared_ptr<Frame> f : frames)
+    for(const std::shared_ptr<Frame> &f : frames)
     {
-        s_frames[QString::fromStdString("frame" + std::to_string(frame_n))] = std::move(f->toJson());
-        frame_n++;
+        if(f->isDamaged())
+            return true;
     }
-    s["frames"] = std::move(s_frames);
+    return false;
+}
 
-    return s;
+///
+/// \brief Animation::frameRevisions
+/// \return the revision of every frame, in order (see Frame::getRevision)
+///
+std::vector<quint64> Animation::frameRevisions() const
+{
+    std::vector<quint64> revisions;
+    for(const std::shared_ptr<Frame> &f : frames)
+        revisions.push_back(f->getRevision());
+    return revisions;
 }
 
 ///
-/// \brief Animation::loadJson replace this Animation's data with that deserialized from the provided Qt JSON object
-/// \param fromJson Qt JSON object with keys height (int), width (int), numberOfFrames (int), and frames (object) [see Frame's constructor that takes JSON]
+/// \brief Animation::restore replace this Animation's data with a snapshot
+/// \param snapshot the snapshot; must hold at least one frame
 ///
-void Animation::loadJson(const QJsonObject& fromJson)
+void Animation::restore(const AnimationSnapshot &snapshot)
 {
-    int frameCount = fromJson["numberOfFrames"].toInt();
-    if(frameCount < 1)
-    {
-        // TODO: display warning
+    if(snapshot.frames.empty())
         return;
-    }
 
-    beginResetModel();
+    frameSize = snapshot.frameSize;
+    std::vector<std::shared_ptr<Frame>> restoredFrames;
+    for(const QImage &image : snapshot.frames)
+        restoredFrames.push_back(std::make_shared<Frame>(image));
 
-    frames.clear();
-    frameSize.setWidth(fromJson["width"].toInt());
-    frameSize.setHeight(fromJson["height"].toInt());
+    replaceAllFrames(std::move(restoredFrames));
+}
+
+///
+/// \brief Animation::restoreLazily replace this Animation's data with frames that are only decoded when first
+///        used (see getFrame), so that even a very large animation opens immediately
+/// \param frameSize size of every frame
+/// \param frameCount number of frames; at least 1
+/// \param decodeFrame returns the canvas of the frame at an index, or a null image if it is damaged (frameDamaged is
+///        emitted then); kept until every frame is decoded
+///
+void Animation::restoreLazily(QSize frameSize, int frameCount, std::function<QImage(int)> decodeFrame)
+{
+    if(frameCount < 1)
+        return;
 
-    QJsonObject jsonFrames = fromJson["frames"].toObject();
+    this->frameSize = frameSize;
+    std::vector<std::shared_ptr<Frame>> lazyFrames;
     for(int i = 0; i < frameCount; i++)
     {
-        QString frameName = QString::fromStdString("frame" + std::to_string(i));
-        QJsonArray f = jsonFrames[frameName].toArray();
-        std::shared_ptr addedFrame = std::make_shared<Frame>(frameSize.width(), frameSize.height(), f);
-        frames.push_back(addedFrame);
-        linkCanvasChanged(addedFrame);
+        std::shared_ptr<Frame> frame = std::make_shared<Frame>(frameSize, [decodeFrame, i] { return decodeFrame(i); });
+        Frame *lazyFrame = frame.get();
+        connect(lazyFrame,
+                &Frame::loadFailed,
+                this,
+                [this, lazyFrame] { emit frameDamaged(rowOf(lazyFrame)); });
+        lazyFrames.push_back(std::move(frame));
     }
 
-    if(frameCount > 0)
-    {
-        emit disableDeleteButton(false);
-    }
+    replaceAllFrames(std::move(lazyFrames));
+}
+
+///
+/// \brief Animation::replaceAllFrames swap in a whole new list of frames and show the first one
+/// \param newFrames the frames; must not be empty
+///
+void Animation::replaceAllFrames(std::vector<std::shared_ptr<Frame>> newFrames)
+{
+    for(const std::shared_ptr<Frame> &f : newFrames)
+        linkCanvasChanged(f);
 
-    endResetModel();
+    //Swap every row out at once: one removal and one insertion, however many frames there are
+    beginRemoveRows(QModelIndex(), 0, (int)frames.size() - 1);
+    frames.clear();
+    endRemoveRows();
+    beginInsertRows(QModelIndex(), 0, (int)newFrames.size() - 1);
+    frames = std::move(newFrames);
+    endInsertRows();
+
+    emit disableDeleteButton(frames.size() == 1);
+    emit setStateofAnimationPreview(frames.size() == 1);
 
     changeFrame(0);
 }
 
 ///
 /// \brief Animation::rowCount used for QListView; gives the number of "rows" in the tabular data to be displayed
-/// \param parent unused
-/// \return the number of frames
+/// \param parent the frame list (an invalid index)
+/// \return the number of frames, or 0 for a frame's children
 ///
 int Animation::rowCount(const QModelIndex& parent) const
 {
-    Q_UNUSED(parent);
+    //Frames have no children
+    if(parent.isValid())
+        return 0;
     return frames.size();
 }
 
 ///
 /// \brief Animation::columnCount used for QListView; gives the number of "columns" in the tabular data to be displayed
-/// \param parent unused
-/// \return 1
+/// \param parent the frame list (an invalid index)
+/// \return 1, or 0 for a frame's children
 ///
 int Animation::columnCount(const QModelIndex& parent) const
 {
-    Q_UNUSED(parent);
-    return 1;
+    return parent.isValid() ? 0 : 1;
 }
 
 ///
@@ -319,20 +391,33 @@ int Animation::getCurrFrameIndex()
 }
 
 ///
-/// \brief Animation::linkCanvasChanged connect the canvasChanged signal on the given frame to code that tracks undo states
+/// \brief Animation::linkCanvasChanged connect the canvasCommitted signal on the given frame to code that tracks undo states
 /// \param new_frame the Frame whose signal to connect to
 ///
 void Animation::linkCanvasChanged(std::shared_ptr<Frame> new_frame)
 {
-    connect(new_frame.get(),
-            &Frame::canvasChanged,
-            [this, new_frame]
+    //Capture a raw pointer: a shared_ptr in the frame's own connection would keep the frame (and, for a lazily
+    //loaded one, the file it decodes from) alive forever. The connection goes away with the frame or this Animation.
+    Frame *frame = new_frame.get();
+    connect(frame,
+            &Frame::canvasCommitted,
+            this,
+            [this, frame](const QRect &changed)
             {
-                if(new_frame->old_canvas == new_frame->canvas)
+                if(!frame->regionChanged(changed))
                     return;
 
-                int idx = std::distance(frames.cbegin(), std::find(frames.cbegin(), frames.cend(), new_frame));
-                emit pushUndoState(UndoState::forFrameChange(idx, std::make_shared<Frame>(new_frame->old_canvas), std::make_shared<Frame>(new_frame->canvas)));
+                int idx = rowOf(frame);
+                if(idx < 0)
+                    return;
+                if(frame->old_canvas.size() != frame->canvas.size())
+                {
+                    // the canvas was resized, so a region of it cannot describe the change
+                    emit pushUndoState(UndoState::forFrameChange(idx, std::make_shared<Frame>(frame->old_canvas), std::make_shared<Frame>(frame->canvas)));
+                    return;
+                }
+
+                emit pushUndoState(UndoState::forRegionChange(idx, changed, frame->old_canvas.copy(changed), frame->canvas.copy(changed)));
             });
 }
 
@@ -356,29 +441,32 @@ QSize Animation:: getFrameSize()
 
 ///
 /// \brief Animation::moveRows used by drag operation
-/// \param start from start locaiton
+/// \param start parent of the moving rows; must be the frame list (an invalid index)
 /// \param startRow row index of start
-/// \param rowsNum count of rows
-/// \param end to end location
+/// \param rowsNum count of rows; only 1 is supported
+/// \param end parent of the destination; must be the frame list (an invalid index)
 /// \param endRow end index
 /// \return
 ///
 bool Animation::moveRows(const QModelIndex &start, int startRow, int rowsNum, const QModelIndex &end, int endRow)
 {
-    //if try to drag somewhere outside, refuse to drag
-    if (startRow < 0 || endRow < 0 || startRow >= rowCount() || endRow >= rowCount())
+    //if try to drag somewhere outside, or move more than one frame, refuse to drag
+    if (start.isValid() || end.isValid() || rowsNum != 1 || startRow < 0 || endRow < 0 || startRow >= rowCount() || endRow >= rowCount())
     {
         return false;
     }
 
-    //change the current frame to other location
-    beginMoveRows(start, startRow, startRow + rowsNum - 1, end, endRow > startRow ? endRow + 1 : endRow);
+    //change the current frame to other location; dropping a frame where it already is isn't a move
+    if (!beginMoveRows(start, startRow, startRow, end, endRow > startRow ? endRow + 1 : endRow))
+    {
+        return false;
+    }
     std::shared_ptr<Frame> movingFrame = frames[startRow];
     frames.erase(frames.begin() + startRow);
     frames.insert(frames.begin() + endRow, movingFrame);
     endMoveRows();
     currFrameIndex = endRow;
-    emit drawFrame(frames[currFrameIndex]);
+    emit drawFrame(loadedFrame(currFrameIndex));
     return true;
 }
 
@@ -399,6 +487,36 @@ Qt::ItemFlags Animation::flags(const QModelIndex &selectedIndex) const
 ///
 std::shared_ptr<Frame> Animation::getFrame(int index) const
 {
+    return loadedFrame(index);
+}
+
+///
+/// \brief Animation::rowOf find a frame without decoding any lazily loaded frames
+/// \param frame the frame
+/// \return its index, or -1 if it isn't in this animation
+///
+int Animation::rowOf(const Frame *frame) const
+{
+    //The current frame is the one being drawn on, so look there first
+    if(currFrameIndex >= 0 && currFrameIndex < (int)frames.size() && frames[currFrameIndex].get() == frame)
+        return currFrameIndex;
+
+    for(size_t i = 0; i < frames.size(); i++)
+    {
+        if(frames[i].get() == frame)
+            return (int)i;
+    }
+    return -1;
+}
+
+///
+/// \brief Animation::loadedFrame get a frame, decoding it first if it was lazily loaded
+/// \param index the frame
+/// \return the frame, with its canvas available
+///
+std::shared_ptr<Frame> Animation::loadedFrame(int index) const
+{
+    frames[index]->ensureLoaded();
     return frames[index];
 }
 
@@ -461,7 +579,7 @@ bool Animation::dropMimeData(const QMimeData *selectedFrame, Qt::DropAction drop
 
     if (sourceRow != currRow)
     {
-        moveRows(index(sourceRow, 0), sourceRow, 1, QModelIndex(), currRow);
+        moveRows(QModelIndex(), sourceRow, 1, QModelIndex(), currRow);
     }
 
     return true;
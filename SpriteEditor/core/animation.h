@@ -2,6 +2,7 @@
 #ifndef ANIMATION_H
 #define ANIMATION_H
 
+#include "animationsnapshot.h"
 #include "frame.h"
 #include <list>
 #include <memory>
@@ -9,11 +10,9 @@
 #include <QColor>
 #include <QDataStream>
 #include <QImage>
-#include <QJsonObject>
 #include <QMimeData>
 #include <QPainter>
 #include <QSize>
-#include <QWidget>
 #include "undostate.h"
 
 ///
@@ -37,21 +36,26 @@ class Animation : public QAbstractListModel
     std::vector<std::shared_ptr<Frame>> animationFrames;
 
     void linkCanvasChanged(std::shared_ptr<Frame> new_frame);
+    void replaceAllFrames(std::vector<std::shared_ptr<Frame>> newFrames);
+    std::shared_ptr<Frame> loadedFrame(int index) const;
 
 public:
     Animation(QObject *parent = nullptr, QSize frameSize = QSize(128, 128));
     void replaceFrame(int targetLocation, std::shared_ptr<Frame> frame, bool pushUndo = true);
+    void patchFrame(int targetLocation, const QRect &region, const QImage &pixels);
     void insertFrame(int targetLocation, std::shared_ptr<Frame> frame, bool pushUndo = true);
     void addFrame(QSize, bool pushUndo = true);
     void setSpeed(double);
     void changeFrame(int);
     void deleteFrame(int targetLocation, bool pushUndo = true);
     void copyFrame(int targetLocation, bool pushUndo = true);
-    void paintEvent(QPaintEvent *event) ;
     std::shared_ptr<Frame> getCurFrame();
     std::shared_ptr<Frame> getPrevFrame();
-    QJsonObject toJson();
-    void loadJson(const QJsonObject& fromJson);
+    AnimationSnapshot snapshot(const std::function<bool(quint64)> &isStored = nullptr, bool deferDecoding = false) const;
+    std::vector<quint64> frameRevisions() const;
+    bool hasDamagedFrames() const;
+    void restore(const AnimationSnapshot &snapshot);
+    void restoreLazily(QSize frameSize, int frameCount, std::function<QImage(int)> decodeFrame);
 
     void changeFrameWhenAnimating(int frameIndex);
 
@@ -67,6 +71,7 @@ public:
     int getFrameIndex();
     QSize getFrameSize();
     std::shared_ptr<Frame> getFrame(int index) const;
+    int rowOf(const Frame *frame) const;
 
     QStringList mimeTypes() const override;
     QMimeData *mimeData(const QModelIndexList &indexList) const override;
@@ -81,6 +86,7 @@ signals:
     void pushUndoState(UndoState s);
     void drawAnimationFrame(std::shared_ptr<Frame>);
     void setStateofAnimationPreview(bool state);
+    void frameDamaged(int index);
 };
 
 Q_DECLARE_METATYPE(std::shared_ptr<Frame>)
@@ -0,0 +1,53 @@
+#ifndef ANIMATIONSNAPSHOT_H
+#define ANIMATIONSNAPSHOT_H
+
+#include <functional>
+#include <QImage>
+#include <QSize>
+#include <QString>
+#include <vector>
+
+///
+/// \brief The AnimationSnapshot struct is a copy of an animation's pixel data, independent of the Animation
+///        and its Frames. Copying one is cheap because QImage is implicitly shared; the pixels are only copied
+///        if the animation is edited while the snapshot is alive. Frames of a lazily loaded file that haven't been
+///        decoded yet may be left to loaders, so a background thread can decode them with decodeFrames.
+///
+struct AnimationSnapshot
+{
+    QSize frameSize;
+    // one ARGB32 canvas per frame, in order; null for a frame left out because its file already holds it, or
+    // for one that loaders decodes
+    std::vector<QImage> frames;
+    // revision of each frame (see Frame::getRevision), or empty if unknown
+    std::vector<quint64> revisions;
+    // for each frame not decoded yet, what decodes its canvas (safe to call from any thread); empty if none
+    std::vector<std::function<QImage()>> loaders;
+
+    ///
+    /// \brief decodeFrames decode every frame left to loaders. Safe to call from any thread.
+    /// \param error set to a message for the user if a frame is damaged
+    /// \return true if every frame has its canvas now
+    ///
+    bool decodeFrames(QString *error = nullptr)
+    {
+        for (size_t i = 0; i < loaders.size() && i < frames.size(); i++)
+        {
+            if (!loaders[i])
+                continue;
+
+            QImage canvas = loaders[i]();
+            if (canvas.size() != frameSize)
+            {
+                if (error)
+                    *error = QString("Frame %1 could not be read from the file it was opened from.").arg(i + 1);
+                return false;
+            }
+            frames[i] = canvas.convertToFormat(QImage::Format_ARGB32);
+        }
+        loaders.clear();
+        return true;
+    }
+};
+
+#endif // ANIMATIONSNAPSHOT_H
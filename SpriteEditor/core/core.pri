@@ -0,0 +1,15 @@
+# Include from a project next to core/ to build against the core library.
+QT += core gui concurrent
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+CORE_OUT = $$shadowed($$PWD)
+win32:CONFIG(release, debug|release): CORE_OUT = $$CORE_OUT/release
+else:win32:CONFIG(debug, debug|release): CORE_OUT = $$CORE_OUT/debug
+
+LIBS += -L$$CORE_OUT -lcore
+
+win32-g++: PRE_TARGETDEPS += $$CORE_OUT/libcore.a
+else:win32: PRE_TARGETDEPS += $$CORE_OUT/core.lib
+else: PRE_TARGETDEPS += $$CORE_OUT/libcore.a
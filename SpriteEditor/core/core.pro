@@ -0,0 +1,55 @@
+# Everything the editor does to a sprite, without widgets, so it also runs with only QtCore and QtGui
+# (for example with QT_QPA_PLATFORM=offscreen).
+TEMPLATE = lib
+TARGET = core
+CONFIG += staticlib
+
+QT       = core gui concurrent
+
+CONFIG += c++17
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    animation.cpp \
+    ditherpattern.cpp \
+    eraser.cpp \
+    frame.cpp \
+    legacyspritefile.cpp \
+    model.cpp \
+    paint.cpp \
+    paintbrush.cpp \
+    paintbucket.cpp \
+    pixelkernels.cpp \
+    spritefile.cpp \
+    spritefilereader.cpp \
+    spritesheet.cpp \
+    stencil.cpp \
+    tool.cpp \
+    toolkernels.cpp \
+    undohistory.cpp \
+    undostate.cpp
+
+HEADERS += \
+    animation.h \
+    animationsnapshot.h \
+    ditherpattern.h \
+    eraser.h \
+    fileerror.h \
+    frame.h \
+    legacyspritefile.h \
+    model.h \
+    paint.h \
+    paintbrush.h \
+    paintbucket.h \
+    pixelkernels.h \
+    spritefile.h \
+    spritefilereader.h \
+    spritesheet.h \
+    stencil.h \
+    tool.h \
+    toolkernels.h \
+    undohistory.h \
+    undostate.h
@@ -0,0 +1,204 @@
+#include "ditherpattern.h"
+#include <algorithm>
+#include "pixelkernels.h"
+
+// rows in the tile are at least this many pixels long so that copies out of it are long runs
+static const int MIN_ROW_LENGTH = 64;
+
+///
+/// \brief DitherPattern::DitherPattern make a pattern that is the primary color everywhere
+/// \param primary ARGB value of the primary color
+///
+DitherPattern::DitherPattern(QRgb primary)
+    : cellWidth(1),
+      cellHeight(1)
+{
+    buildTile({false}, primary, primary);
+}
+
+///
+/// \brief DitherPattern::DitherPattern make an ordered-dither (Bayer) pattern
+/// \param type which matrix to use; Solid ignores the secondary color, Custom is treated as Solid
+/// \param secondaryPercent how much of the pattern (0 - 100) is the secondary color
+/// \param primary ARGB value of the primary color
+/// \param secondary ARGB value of the secondary color
+///
+DitherPattern::DitherPattern(Type type, int secondaryPercent, QRgb primary, QRgb secondary)
+{
+    int size = 1;
+    switch (type)
+    {
+        case Type::Bayer2x2:
+            size = 2;
+            break;
+        case Type::Bayer4x4:
+            size = 4;
+            break;
+        case Type::Bayer8x8:
+            size = 8;
+            break;
+        case Type::Solid:
+        case Type::Custom:
+            break;
+    }
+    cellWidth = size;
+    cellHeight = size;
+
+    //A cell shows the secondary color when its threshold is among the highest secondaryCount thresholds
+    int cellCount = size * size;
+    int secondaryCount = size == 1 ? 0 : (std::clamp(secondaryPercent, 0, 100) * cellCount + 50) / 100;
+    std::vector<int> thresholds = bayerMatrix(size);
+    std::vector<bool> secondaryCells(cellCount);
+    for (int i = 0; i < cellCount; i++)
+    {
+        secondaryCells[i] = thresholds[i] >= cellCount - secondaryCount;
+    }
+    buildTile(secondaryCells, primary, secondary);
+}
+
+///
+/// \brief DitherPattern::DitherPattern make a custom pattern
+/// \param width width of the repeating cell
+/// \param height height of the repeating cell
+/// \param secondaryCells width*height flags, row by row; true where the secondary color is used
+/// \param primary ARGB value of the primary color
+/// \param secondary ARGB value of the secondary color
+///
+DitherPattern::DitherPattern(int width, int height, const std::vector<bool> &secondaryCells, QRgb primary, QRgb secondary)
+    : cellWidth(std::max(width, 1)),
+      cellHeight(std::max(height, 1))
+{
+    std::vector<bool> cells(secondaryCells);
+    cells.resize(cellWidth * cellHeight, false);
+    buildTile(cells, primary, secondary);
+}
+
+///
+/// \brief DitherPattern::typeNames names to show for each Type, in the order of the enum
+/// \return list of names
+///
+QStringList DitherPattern::typeNames()
+{
+    return { "Solid", "Checkerboard (Bayer 2x2)", "Bayer 4x4", "Bayer 8x8", "Custom" };
+}
+
+///
+/// \brief DitherPattern::isSolid
+/// \return true if the pattern is a single color, so tools can fill with colorAt(0, 0) instead of copying the tile
+///
+bool DitherPattern::isSolid() const
+{
+    return solid;
+}
+
+///
+/// \brief DitherPattern::colorAt
+/// \param x X coordinate of the pixel
+/// \param y Y coordinate of the pixel
+/// \return ARGB value the pattern has at (x,y)
+///
+QRgb DitherPattern::colorAt(int x, int y) const
+{
+    return *rowAt(x, y);
+}
+
+///
+/// \brief DitherPattern::fillRow copy the pattern into count pixels of a canvas row
+/// \param dst pixel of the canvas at (x,y)
+/// \param x X coordinate of dst
+/// \param y Y coordinate of dst
+/// \param count number of pixels
+///
+void DitherPattern::fillRow(QRgb *dst, int x, int y, int count) const
+{
+    while (count > 0)
+    {
+        int offset = x % cellWidth;
+        int run = std::min(count, rowLength - offset);
+        PixelKernels::copyRow(dst, rowAt(x, y), run);
+        dst += run;
+        x += run;
+        count -= run;
+    }
+}
+
+///
+/// \brief DitherPattern::fillRowMasked same as fillRow, but only where the mask byte is nonzero
+/// \param dst pixel of the canvas at (x,y)
+/// \param mask one byte per pixel
+/// \param x X coordinate of dst
+/// \param y Y coordinate of dst
+/// \param count number of pixels
+///
+void DitherPattern::fillRowMasked(QRgb *dst, const uchar *mask, int x, int y, int count) const
+{
+    while (count > 0)
+    {
+        int offset = x % cellWidth;
+        int run = std::min(count, rowLength - offset);
+        PixelKernels::copyRowMasked(dst, rowAt(x, y), mask, run);
+        dst += run;
+        mask += run;
+        x += run;
+        count -= run;
+    }
+}
+
+///
+/// \brief DitherPattern::buildTile render the repeating cell into rows at least MIN_ROW_LENGTH long
+/// \param secondaryCells cellWidth*cellHeight flags, row by row
+/// \param primary ARGB value of the primary color
+/// \param secondary ARGB value of the secondary color
+///
+void DitherPattern::buildTile(const std::vector<bool> &secondaryCells, QRgb primary, QRgb secondary)
+{
+    rowLength = ((MIN_ROW_LENGTH + cellWidth - 1) / cellWidth) * cellWidth;
+    tile.resize(rowLength * cellHeight);
+    for (int y = 0; y < cellHeight; y++)
+    {
+        for (int x = 0; x < rowLength; x++)
+        {
+            tile[y * rowLength + x] = secondaryCells[y * cellWidth + x % cellWidth] ? secondary : primary;
+        }
+    }
+    solid = std::all_of(tile.begin(), tile.end(), [this](QRgb color) { return color == tile[0]; });
+}
+
+///
+/// \brief DitherPattern::rowAt find the tile pixel for a canvas pixel
+/// \param x X coordinate on the canvas (not negative)
+/// \param y Y coordinate on the canvas (not negative)
+/// \return pointer into the tile; at least rowLength - x % cellWidth pixels can be read from it
+///
+const QRgb *DitherPattern::rowAt(int x, int y) const
+{
+    return &tile[(y % cellHeight) * rowLength + x % cellWidth];
+}
+
+///
+/// \brief DitherPattern::bayerMatrix build the size by size Bayer threshold matrix
+/// \param size a power of two
+/// \return size*size thresholds from 0 to size*size-1, row by row
+///
+std::vector<int> DitherPattern::bayerMatrix(int size)
+{
+    std::vector<int> matrix{0};
+    //Each step: M(2n) = [4M, 4M+2; 4M+3, 4M+1]
+    for (int n = 1; n < size; n *= 2)
+    {
+        std::vector<int> bigger(4 * n * n);
+        for (int y = 0; y < n; y++)
+        {
+            for (int x = 0; x < n; x++)
+            {
+                int value = 4 * matrix[y * n + x];
+                bigger[y * 2 * n + x] = value;
+                bigger[y * 2 * n + x + n] = value + 2;
+                bigger[(y + n) * 2 * n + x] = value + 3;
+                bigger[(y + n) * 2 * n + x + n] = value + 1;
+            }
+        }
+        matrix = std::move(bigger);
+    }
+    return matrix;
+}
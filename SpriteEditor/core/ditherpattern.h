@@ -0,0 +1,43 @@
+#ifndef DITHERPATTERN_H
+#define DITHERPATTERN_H
+
+#include <QRgb>
+#include <QStringList>
+#include <vector>
+
+///
+/// \brief The DitherPattern class is an ordered-dither pattern between a primary and a secondary color,
+///        precomputed into a tile whose rows repeat horizontally so tools can copy whole rows out of it.
+///
+class DitherPattern
+{
+public:
+    enum class Type { Solid, Bayer2x2, Bayer4x4, Bayer8x8, Custom };
+
+    DitherPattern(QRgb primary);
+    DitherPattern(Type type, int secondaryPercent, QRgb primary, QRgb secondary);
+    DitherPattern(int width, int height, const std::vector<bool> &secondaryCells, QRgb primary, QRgb secondary);
+
+    static QStringList typeNames();
+
+    bool isSolid() const;
+    QRgb colorAt(int x, int y) const;
+    void fillRow(QRgb *dst, int x, int y, int count) const;
+    void fillRowMasked(QRgb *dst, const uchar *mask, int x, int y, int count) const;
+
+private:
+    int cellWidth;
+    int cellHeight;
+
+    // cellHeight rows of rowLength pixels each; rowLength is a multiple of cellWidth
+    int rowLength;
+    std::vector<QRgb> tile;
+    // true if every pixel of the tile is the same color
+    bool solid;
+
+    void buildTile(const std::vector<bool> &secondaryCells, QRgb primary, QRgb secondary);
+    const QRgb *rowAt(int x, int y) const;
+    static std::vector<int> bayerMatrix(int size);
+};
+
+#endif // DITHERPATTERN_H
@@ -0,0 +1,39 @@
+// Code style reviewed by Kyle Holland on 4/5/2023
+#include "eraser.h"
+
+///
+/// \brief Eraser::useToolAtPoint Uses eraser at point with coordinates (x,y) This erases the
+///        pixels within the tool.
+/// \param frame to use eraser on
+/// \param paintSettings Settings for the tool. Only use toolSize for eraser
+/// \param x coordinate of base of eraser
+/// \param y coordinate of base of eraser
+///
+void Eraser::useToolAtPoint(const std::shared_ptr<Frame> &frame, const Paint &paintSettings, int x, int y)
+{
+    //A point is a line with no length
+    useToolOnLine(frame, paintSettings, x, y, x, y);
+}
+
+
+///
+/// \brief Eraser::useToolOnPolyline Uses eraser along the lines connecting the given points, in one pass.
+///        This erases the pixels within the tool, with size of line dependent on paintSettings.
+/// \param frame to use eraser on
+/// \param paintSettings Settings for the tool. Use toolSize for eraser.
+/// \param points the points to connect, in order
+///
+void Eraser::useToolOnPolyline(const std::shared_ptr<Frame> &frame, const Paint &paintSettings, const QPolygon &points)
+{
+    Stencil stencil = polylineStencil(frame->canvas, paintSettings.getToolSize(), points);
+    QRect bounds = stencil.getBounds();
+    if (bounds.isEmpty())
+    {
+        return;
+    }
+    ToolKernels::applyStencil(frame->canvas, stencil, BlendMode::Erase, *paintSettings.getPattern());
+
+    frame->markDirty(bounds);
+    frame->afterCanvasChanged();
+}
+
@@ -0,0 +1,19 @@
+#ifndef FILEERROR_H
+#define FILEERROR_H
+
+#include <QString>
+
+///
+/// \brief setError report an error to a caller that asked for one, as the file readers and writers do
+/// \param error where to put the message, or nullptr
+/// \param message the message
+///
+inline void setError(QString *error, const QString &message)
+{
+    if (error)
+    {
+        *error = message;
+    }
+}
+
+#endif // FILEERROR_H
@@ -0,0 +1,312 @@
+// Code style reviewed by Nickolas Solum on 4/5/2023
+#include "frame.h"
+#include "pixelkernels.h"
+#include <atomic>
+#include <QPainter>
+#include <QPalette>
+
+// last revision handed out; see Frame::getRevision. Frames are made on worker threads too (e.g. by the cli).
+static std::atomic<quint64> lastRevision{0};
+
+///
+/// \brief Frame::Frame frame constructor, setting up the size and background color
+/// \param width
+/// \param height
+///
+Frame::Frame(int width, int height)
+    : frameWidth(width),
+      frameHeight(height),
+      revision(++lastRevision),
+      canvas(width, height, QImage::Format_ARGB32)
+{
+    QColor frameColor(Qt::transparent);
+    canvas.fill(frameColor);
+    afterCanvasChanged();
+}
+
+///
+/// \brief Frame::Frame copy constructor for Frame. Copies just the frame data; QObject signals/slots will not be copied.
+/// \param other Frame to copy
+///
+Frame::Frame(const Frame& other)
+    : QObject(nullptr)
+{
+    frameWidth = other.frameWidth;
+    frameHeight = other.frameHeight;
+    canvas = other.canvas;
+    old_canvas = canvas;
+    loader = other.loader;
+    damagedRevision = other.damagedRevision;
+    // same pixels, so the copy can share the original's revision until either is edited
+    revision = other.revision;
+}
+
+///
+/// \brief Frame::Frame make a Frame from a QImage
+/// \param fromImg QImage to copy into this Frame; tools expect the canvas in QImage::Format_ARGB32
+///
+Frame::Frame(const QImage& fromImg)
+    : QObject(nullptr)
+{
+    frameWidth = fromImg.width();
+    frameHeight = fromImg.height();
+    canvas = fromImg.convertToFormat(QImage::Format_ARGB32);
+    old_canvas = canvas;
+    revision = ++lastRevision;
+}
+
+///
+/// \brief Frame::Frame make a Frame whose canvas is only decoded when first needed. Code that reads or writes
+///        canvas directly must call ensureLoaded first.
+/// \param size size of the canvas
+/// \param canvasLoader returns the canvas; called at most once
+///
+Frame::Frame(const QSize &size, std::function<QImage()> canvasLoader)
+    : QObject(nullptr),
+      frameWidth(size.width()),
+      frameHeight(size.height()),
+      loader(std::move(canvasLoader)),
+      revision(++lastRevision)
+{
+
+}
+
+///
+/// \brief Frame::isLoaded
+/// \return true if the canvas is available
+///
+bool Frame::isLoaded() const
+{
+    return !loader;
+}
+
+///
+/// \brief Frame::ensureLoaded decode the canvas of a lazily loaded frame, if that hasn't happened yet. If its data is
+///        damaged the canvas is left empty and loadFailed is emitted; the frame keeps its revision, so a save that
+///        only adds changed frames to the file leaves the original data there (see isDamaged).
+///
+void Frame::ensureLoaded()
+{
+    if(!loader)
+        return;
+
+    QImage loaded = loader();
+    loader = nullptr;
+    if(loaded.size() != QSize(frameWidth, frameHeight))
+    {
+        // show an empty frame rather than nothing
+        loaded = QImage(frameWidth, frameHeight, QImage::Format_ARGB32);
+        loaded.fill(Qt::transparent);
+        damagedRevision = revision;
+        canvas = loaded;
+        old_canvas = canvas;
+        emit loadFailed();
+        return;
+    }
+    canvas = loaded.convertToFormat(QImage::Format_ARGB32);
+    old_canvas = canvas;
+}
+
+///
+/// \brief Frame::isDamaged
+/// \return true if the lazily loaded canvas couldn't be decoded and the empty one shown instead hasn't been drawn
+///         on; its pixels aren't the frame's real ones, so they must not be written over the frame's data
+///
+bool Frame::isDamaged() const
+{
+    return damagedRevision != 0 && damagedRevision == revision;
+}
+
+///
+/// \brief Frame::getLoader
+/// \return what decodes the canvas of a lazily loaded frame that hasn't been decoded yet, or an empty function. It
+///         doesn't touch the Frame, so another thread may call it on a copy of the pixels (see Animation::snapshot).
+///
+std::function<QImage()> Frame::getLoader() const
+{
+    return loader;
+}
+
+///
+/// \brief Frame::getRevision
+/// \return a number that changes whenever the canvas does (even if it isn't loaded yet); two frames with the
+///         same revision have the same pixels
+///
+quint64 Frame::getRevision() const
+{
+    return revision;
+}
+
+///
+/// \brief Frame::afterCanvasChanged call after modifying this Frame's canvas. Only the area reported through
+///        markDirty is snapshotted; if nothing was reported, the whole canvas is assumed to have changed.
+///
+void Frame::afterCanvasChanged()
+{
+    QRect dirty = dirtyRect.isNull() ? canvas.rect() : dirtyRect;
+    dirtyRect = QRect();
+    revision = ++lastRevision;
+
+    emit canvasChanged(dirty);
+    if(transactionOpen)
+    {
+        // keep old_canvas at the state from before the transaction until it is committed
+        transactionRect |= dirty;
+        return;
+    }
+
+    emit canvasCommitted(dirty); // slots will see canvas with the new state and old_canvas with the old state
+    syncSnapshot(dirty);
+}
+
+///
+/// \brief Frame::beginTransaction start grouping changes (e.g. a whole brush stroke) so that
+///        canvasCommitted is emitted once, covering every change, when commitTransaction is called
+///
+void Frame::beginTransaction()
+{
+    transactionOpen = true;
+}
+
+///
+/// \brief Frame::commitTransaction finish the transaction started by beginTransaction
+///
+void Frame::commitTransaction()
+{
+    if(!transactionOpen)
+        return;
+
+    transactionOpen = false;
+    QRect changed = transactionRect;
+    transactionRect = QRect();
+    if(changed.isNull())
+        return;
+
+    emit canvasCommitted(changed);
+    syncSnapshot(changed);
+}
+
+///
+/// \brief Frame::restoreRegion write pixels back into the canvas without committing a change (used by undo/redo)
+/// \param rect area of the canvas to overwrite
+/// \param pixels image the size of rect holding the pixels to write
+///
+void Frame::restoreRegion(const QRect &rect, const QImage &pixels)
+{
+    QRect area = rect & canvas.rect();
+    if(area.isEmpty() || pixels.size() != rect.size())
+        return;
+
+    QImage source = pixels.convertToFormat(QImage::Format_ARGB32);
+    int sourceX = area.left() - rect.left();
+    int sourceY = area.top() - rect.top();
+    for(int y = 0; y < area.height(); y++)
+    {
+        PixelKernels::copyRow(reinterpret_cast<QRgb*>(canvas.scanLine(area.top() + y)) + area.left(),
+                              reinterpret_cast<const QRgb*>(source.constScanLine(sourceY + y)) + sourceX,
+                              area.width());
+    }
+
+    revision = ++lastRevision;
+    emit canvasChanged(area);
+    syncSnapshot(area);
+}
+
+///
+/// \brief Frame::markDirty record that a tool has modified pixels inside rect. Call before afterCanvasChanged.
+/// \param rect area of the canvas that was touched (clipped to the canvas)
+///
+void Frame::markDirty(const QRect &rect)
+{
+    dirtyRect |= rect & canvas.rect();
+}
+
+///
+/// \brief Frame::regionChanged compare canvas against old_canvas inside rect only
+/// \param rect area to compare
+/// \return true if any pixel inside rect differs from the last snapshot
+///
+bool Frame::regionChanged(const QRect &rect) const
+{
+    if(old_canvas.size() != canvas.size() || old_canvas.format() != canvas.format())
+        return true;
+    if(old_canvas.constBits() == canvas.constBits()) // still implicitly shared, so identical
+        return false;
+
+    QRect area = rect & canvas.rect();
+    for(int y = area.top(); y <= area.bottom(); y++)
+    {
+        const QRgb *oldRow = reinterpret_cast<const QRgb*>(old_canvas.constScanLine(y)) + area.left();
+        const QRgb *newRow = reinterpret_cast<const QRgb*>(canvas.constScanLine(y)) + area.left();
+        if(!PixelKernels::rowsEqual(oldRow, newRow, area.width()))
+            return true;
+    }
+    return false;
+}
+
+///
+/// \brief Frame::syncSnapshot copy the pixels inside rect from canvas into old_canvas
+/// \param rect area to copy
+///
+void Frame::syncSnapshot(const QRect &rect)
+{
+    if(old_canvas.size() != canvas.size() || old_canvas.format() != canvas.format())
+    {
+        // implicitly shared; the first write to either image detaches it
+        old_canvas = canvas;
+        return;
+    }
+    if(old_canvas.constBits() == canvas.constBits())
+        return;
+
+    QRect area = rect & canvas.rect();
+    for(int y = area.top(); y <= area.bottom(); y++)
+    {
+        PixelKernels::copyRow(reinterpret_cast<QRgb*>(old_canvas.scanLine(y)) + area.left(),
+                              reinterpret_cast<const QRgb*>(canvas.constScanLine(y)) + area.left(),
+                              area.width());
+    }
+}
+
+///
+/// \brief Frame::getFrameWidth Gets the frame's width
+/// \return The frame's width
+///
+int Frame::getFrameWidth()
+{
+    return frameWidth;
+}
+
+///
+/// \brief Frame::getFrameHeight Gets the frame's height
+/// \return The frame's height
+///
+int Frame::getFrameHeight()
+{
+    return frameHeight;
+}
+
+///
+/// \brief Frame::setFrameDimensions Changes the frames dimensions
+/// \param newWidth - the desired width of the frame
+/// \param newHeight - the desired height of the frame
+///
+void Frame::setFrameDimensions(int newWidth, int newHeight)
+{
+    ensureLoaded();
+    frameWidth = newWidth;
+    frameHeight = newHeight;
+    canvas = scaledCanvas(canvas, QSize(frameWidth, frameHeight));
+    afterCanvasChanged();
+}
+
+///
+/// \brief Frame::scaledCanvas scale a canvas the way resizing a frame does
+/// \param canvas the canvas
+/// \param size the size to scale it to
+/// \return the scaled canvas
+///
+QImage Frame::scaledCanvas(const QImage &canvas, QSize size)
+{
+    return canvas.scaled(size);
+}
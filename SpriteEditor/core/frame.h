@@ -0,0 +1,81 @@
+// Code style reviewed by Nickolas Solum on 4/5/2023
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <functional>
+#include <QImage>
+#include <QObject>
+#include <QRect>
+
+///
+/// \brief The Frame class that contains the basic information of frame
+/// \author Joey Cai, Kyle Holland
+///
+class Frame : public QObject
+{
+    Q_OBJECT
+
+private:
+    int frameWidth;
+    int frameHeight;
+
+    // union of the areas touched since the last afterCanvasChanged
+    QRect dirtyRect;
+
+    // union of the areas changed since beginTransaction
+    bool transactionOpen = false;
+    QRect transactionRect;
+
+    void syncSnapshot(const QRect &rect);
+
+    // set until the canvas of a lazily loaded frame has been decoded; see ensureLoaded
+    std::function<QImage()> loader;
+
+    // changes whenever canvas does; frames with the same revision have the same pixels
+    quint64 revision;
+
+    // the revision whose lazily loaded canvas couldn't be decoded, or 0; see isDamaged
+    quint64 damagedRevision = 0;
+
+public:
+    enum class EditMode { Editable, ReadOnly };
+
+    QImage old_canvas;
+    QImage canvas;
+    //QImage animationPreviewCanvas;
+    Frame(int width, int height);
+    Frame(const Frame& other);
+    Frame(const QImage& fromImg);
+    Frame(const QSize &size, std::function<QImage()> canvasLoader);
+
+    bool isLoaded() const;
+    void ensureLoaded();
+    bool isDamaged() const;
+    std::function<QImage()> getLoader() const;
+    quint64 getRevision() const;
+
+    //const QImage &getFrame() const;
+
+    // call after any modification to canvas
+    void afterCanvasChanged();
+    void markDirty(const QRect &rect);
+    bool regionChanged(const QRect &rect) const;
+
+    // group every change until commitTransaction into a single canvasCommitted
+    void beginTransaction();
+    void commitTransaction();
+
+    void restoreRegion(const QRect &rect, const QImage &pixels);
+
+    int getFrameWidth();
+    int getFrameHeight();
+    void setFrameDimensions(int width, int height);
+    static QImage scaledCanvas(const QImage &canvas, QSize size);
+
+signals:
+    void canvasChanged(const QRect &dirty);
+    void canvasCommitted(const QRect &changed);
+    void loadFailed();
+};
+
+#endif // FRAME_H
@@ -0,0 +1,832 @@
+#include "legacyspritefile.h"
+#include "fileerror.h"
+#include "pixelkernels.h"
+#include "spritefile.h"
+#include <algorithm>
+#include <map>
+#include <QBuffer>
+#include <QtConcurrent>
+#include <QtEndian>
+#include <vector>
+
+// bytes of text read from the device at a time
+static const qint64 CHUNK_SIZE = 1 << 16;
+
+// most bytes of frame text held at once while frames are encoded or parsed on the thread pool, a whole frame per task
+static const qint64 WINDOW_BYTES = 64 << 20;
+
+// most bytes of text one pixel takes: "[255,255,255,255]," as an array, or less than six as base64
+static const qint64 MAX_PIXEL_TEXT = 18;
+
+///
+/// \brief The JsonTokenizer class pulls JSON tokens out of a device a chunk at a time, so only one chunk of the
+///        text is ever in memory
+///
+class JsonTokenizer
+{
+public:
+    explicit JsonTokenizer(QIODevice *device);
+
+    char peek();
+    bool consume(char expected);
+    bool readString(QByteArray &text);
+    bool readNumber(double &number);
+    bool skipValue();
+    bool readRawValue(QByteArray &text);
+
+private:
+    bool fill();
+
+    QIODevice *device;
+    QByteArray chunk;
+    qsizetype position = 0;
+};
+
+///
+/// \brief JsonTokenizer::JsonTokenizer constructor
+/// \param device open, readable device to take the text from
+///
+JsonTokenizer::JsonTokenizer(QIODevice *device)
+    : device(device)
+{
+
+}
+
+///
+/// \brief JsonTokenizer::fill read the next chunk if all of this one has been used
+/// \return true if there is text left
+///
+bool JsonTokenizer::fill()
+{
+    if (position < chunk.size())
+    {
+        return true;
+    }
+    chunk = device->read(CHUNK_SIZE);
+    position = 0;
+    return !chunk.isEmpty();
+}
+
+///
+/// \brief JsonTokenizer::peek skip whitespace
+/// \return the next character, which is not consumed, or '\0' at the end of the text
+///
+char JsonTokenizer::peek()
+{
+    while (fill())
+    {
+        char c = chunk.at(position);
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+        {
+            return c;
+        }
+        position++;
+    }
+    return '\0';
+}
+
+///
+/// \brief JsonTokenizer::consume skip whitespace, then consume a character if it is the expected one
+/// \param expected the character
+/// \return true if it was consumed
+///
+bool JsonTokenizer::consume(char expected)
+{
+    if (peek() != expected)
+    {
+        return false;
+    }
+    position++;
+    return true;
+}
+
+///
+/// \brief JsonTokenizer::readString consume a string
+/// \param text set to the string; \u escapes become '?', since only the ASCII keys of the format matter here
+/// \return true if a whole string was read
+///
+bool JsonTokenizer::readString(QByteArray &text)
+{
+    text.clear();
+    if (!consume('"'))
+    {
+        return false;
+    }
+    while (fill())
+    {
+        // copy the plain run up to the next quote or escape in one go; base64 rows are long runs
+        const char *start = chunk.constData() + position;
+        const char *end = chunk.constData() + chunk.size();
+        const char *plain = start;
+        while (plain != end && *plain != '"' && *plain != '\\')
+        {
+            plain++;
+        }
+        text.append(start, plain - start);
+        position += plain - start;
+        if (plain == end)
+        {
+            continue;
+        }
+
+        char c = chunk.at(position++);
+        if (c == '"')
+        {
+            return true;
+        }
+
+        if (!fill())
+        {
+            return false;
+        }
+        char escaped = chunk.at(position++);
+        switch (escaped)
+        {
+            case 'b': text.append('\b'); break;
+            case 'f': text.append('\f'); break;
+            case 'n': text.append('\n'); break;
+            case 'r': text.append('\r'); break;
+            case 't': text.append('\t'); break;
+            case 'u':
+                for (int i = 0; i < 4; i++)
+                {
+                    if (!fill())
+                    {
+                        return false;
+                    }
+                    position++;
+                }
+                text.append('?');
+                break;
+            default: text.append(escaped); break;
+        }
+    }
+    return false;
+}
+
+///
+/// \brief JsonTokenizer::readNumber consume a number
+/// \param number set to the number
+/// \return true if a number was read
+///
+bool JsonTokenizer::readNumber(double &number)
+{
+    peek();
+    char text[32];
+    int length = 0;
+    while (fill())
+    {
+        char c = chunk.at(position);
+        if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'))
+        {
+            break;
+        }
+        if (length == (int)sizeof(text))
+        {
+            return false;
+        }
+        text[length++] = c;
+        position++;
+    }
+
+    bool ok = false;
+    number = QByteArray::fromRawData(text, length).toDouble(&ok);
+    return ok;
+}
+
+///
+/// \brief JsonTokenizer::skipValue consume a value of any type, without keeping it
+/// \return true if a whole value was consumed
+///
+bool JsonTokenizer::skipValue()
+{
+    QByteArray ignored;
+    switch (peek())
+    {
+        case '\0':
+            return false;
+        case '"':
+            return readString(ignored);
+        case '{':
+        case '[':
+        {
+            int depth = 0;
+            do
+            {
+                char c = peek();
+                if (c == '"')
+                {
+                    // strings may hold brackets
+                    if (!readString(ignored))
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+                if (c == '\0')
+                {
+                    return false;
+                }
+                position++;
+                if (c == '{' || c == '[')
+                {
+                    depth++;
+                }
+                else if (c == '}' || c == ']')
+                {
+                    depth--;
+                }
+            } while (depth > 0);
+            return true;
+        }
+        default:
+        {
+            // a number, true, false or null
+            int length = 0;
+            while (fill())
+            {
+                char c = chunk.at(position);
+                if (c == ',' || c == '}' || c == ']' || c == ' ' || c == '\n' || c == '\r' || c == '\t')
+                {
+                    break;
+                }
+                position++;
+                length++;
+            }
+            return length > 0;
+        }
+    }
+}
+
+///
+/// \brief JsonTokenizer::readRawValue consume an array or object, keeping its text as it is
+/// \param text set to the text
+/// \return true if a whole array or object was consumed
+///
+bool JsonTokenizer::readRawValue(QByteArray &text)
+{
+    text.clear();
+    char first = peek();
+    if (first != '[' && first != '{')
+    {
+        return false;
+    }
+
+    int depth = 0;
+    bool inString = false;
+    bool escaped = false;
+    while (fill())
+    {
+        // copy a chunk's worth at a time, stopping after the bracket that closes the value
+        const char *start = chunk.constData() + position;
+        const char *end = chunk.constData() + chunk.size();
+        const char *c = start;
+        bool closed = false;
+        for (; c != end && !closed; c++)
+        {
+            if (inString)
+            {
+                if (escaped)
+                {
+                    escaped = false;
+                }
+                else if (*c == '\\')
+                {
+                    escaped = true;
+                }
+                else if (*c == '"')
+                {
+                    inString = false;
+                }
+            }
+            else if (*c == '"')
+            {
+                inString = true;
+            }
+            else if (*c == '[' || *c == '{')
+            {
+                depth++;
+            }
+            else if (*c == ']' || *c == '}')
+            {
+                closed = --depth == 0;
+            }
+        }
+        text.append(start, c - start);
+        position += c - start;
+        if (closed)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+///
+/// \brief readBase64Row parse one row of a frame stored as a string (version 2)
+/// \param json the text, at the row
+/// \param row set to the row's pixels
+/// \return true if the row was parsed
+///
+static bool readBase64Row(JsonTokenizer &json, std::vector<QRgb> &row)
+{
+    QByteArray text;
+    if (!json.readString(text))
+    {
+        return false;
+    }
+    QByteArray::FromBase64Result decoded = QByteArray::fromBase64Encoding(text, QByteArray::AbortOnBase64DecodingErrors);
+    qsizetype width = decoded.decoded.size() / (qsizetype)sizeof(QRgb);
+    if (!decoded || decoded.decoded.size() % sizeof(QRgb) != 0 || width > SpriteFile::MAX_FRAME_SIDE)
+    {
+        return false;
+    }
+    row.resize(width);
+    qFromLittleEndian<quint32>(decoded.decoded.constData(), width, row.data());
+    return true;
+}
+
+///
+/// \brief readRow parse one row of a frame: an array of [r, g, b, a] arrays, or in version 2 a string
+/// \param json the text, at the row
+/// \param row set to the row's pixels
+/// \return true if the row was parsed
+///
+static bool readRow(JsonTokenizer &json, std::vector<QRgb> &row)
+{
+    // each row says which form it is in, so files of either version read the same way
+    if (json.peek() == '"')
+    {
+        return readBase64Row(json, row);
+    }
+
+    row.clear();
+    if (!json.consume('['))
+    {
+        return false;
+    }
+    if (json.consume(']'))
+    {
+        return true;
+    }
+
+    do
+    {
+        if (!json.consume('[') || (int)row.size() == SpriteFile::MAX_FRAME_SIDE)
+        {
+            return false;
+        }
+        int channels[4] = { 0, 0, 0, 0 };
+        int count = 0;
+        if (!json.consume(']'))
+        {
+            do
+            {
+                double value;
+                if (!json.readNumber(value))
+                {
+                    return false;
+                }
+                if (count < 4)
+                {
+                    channels[count++] = (int)qBound(0.0, value, 255.0);
+                }
+            } while (json.consume(','));
+            if (!json.consume(']'))
+            {
+                return false;
+            }
+        }
+        row.push_back(qRgba(channels[0], channels[1], channels[2], channels[3]));
+    } while (json.consume(','));
+    return json.consume(']');
+}
+
+///
+/// \brief readFrame parse one frame: an array of rows
+/// \param json the text, at the frame
+/// \param size the frame size if the file gave it before the frames, else empty
+/// \param canvas set to the frame. If the size is known each row is written straight into it; otherwise the rows
+///        are kept until the frame ends and canvas is sized to fit them.
+/// \return true if the frame was parsed
+///
+static bool readFrame(JsonTokenizer &json, const QSize &size, QImage &canvas)
+{
+    if (!json.consume('['))
+    {
+        return false;
+    }
+    if (!size.isEmpty())
+    {
+        canvas = QImage(size, QImage::Format_ARGB32);
+        canvas.fill(Qt::transparent);
+    }
+
+    std::vector<QRgb> row;
+    std::vector<std::vector<QRgb>> rows;
+    int y = 0;
+    if (!json.consume(']'))
+    {
+        do
+        {
+            if (!readRow(json, row) || y == SpriteFile::MAX_FRAME_SIDE)
+            {
+                return false;
+            }
+            if (size.isEmpty())
+            {
+                rows.push_back(std::move(row));
+            }
+            else if (y < size.height())
+            {
+                PixelKernels::copyRow(reinterpret_cast<QRgb*>(canvas.scanLine(y)), row.data(),
+                                      std::min<int>(row.size(), size.width()));
+            }
+            y++;
+        } while (json.consume(','));
+        if (!json.consume(']'))
+        {
+            return false;
+        }
+    }
+
+    if (size.isEmpty())
+    {
+        size_t width = 0;
+        for (const std::vector<QRgb> &r : rows)
+        {
+            width = std::max(width, r.size());
+        }
+        canvas = QImage(width, rows.size(), QImage::Format_ARGB32);
+        canvas.fill(Qt::transparent);
+        for (size_t r = 0; r < rows.size(); r++)
+        {
+            PixelKernels::copyRow(reinterpret_cast<QRgb*>(canvas.scanLine(r)), rows[r].data(), rows[r].size());
+        }
+    }
+    return true;
+}
+
+///
+/// \brief The FrameText struct is one frame's text, waiting to be parsed on the thread pool
+///
+struct FrameText
+{
+    int index;
+    QByteArray text;
+};
+
+///
+/// \brief The ParsedFrame struct is a frame parsed on the thread pool
+///
+struct ParsedFrame
+{
+    bool valid = false;
+    QImage canvas;
+};
+
+///
+/// \brief parseFrames parse frames on the thread pool, then take them in file order
+/// \param pending the frames' text; emptied
+/// \param size the frame size if the file gave it before the frames, else empty
+/// \param frames filled with each frame, by the number in its key
+/// \return true if every frame was parsed
+///
+static bool parseFrames(QList<FrameText> &pending, const QSize &size, std::map<int, QImage> &frames)
+{
+    auto parse = [size](const FrameText &frame)
+    {
+        ParsedFrame parsed;
+        QBuffer buffer;
+        buffer.setData(frame.text);
+        if (buffer.open(QIODevice::ReadOnly))
+        {
+            JsonTokenizer json(&buffer);
+            parsed.valid = readFrame(json, size, parsed.canvas) && json.peek() == '\0';
+        }
+        return parsed;
+    };
+    QList<ParsedFrame> parsed = QtConcurrent::blockingMapped<QList<ParsedFrame>>(pending, parse);
+
+    bool ok = true;
+    for (int k = 0; k < parsed.size() && ok; k++)
+    {
+        ok = parsed[k].valid;
+        frames[pending[k].index] = std::move(parsed[k].canvas);
+    }
+    pending.clear();
+    return ok;
+}
+
+///
+/// \brief readFrames parse the frames object. Frames are parsed on the thread pool a few at a time, holding at most
+///        about WINDOW_BYTES of their text; frames known to be too large for that are parsed straight from the device.
+/// \param json the text, at the object
+/// \param size the frame size if the file gave it before the frames, else empty
+/// \param frames filled with each frame, by the number in its key
+/// \return true if the object was parsed
+///
+static bool readFrames(JsonTokenizer &json, const QSize &size, std::map<int, QImage> &frames)
+{
+    if (!json.consume('{'))
+    {
+        return false;
+    }
+    if (json.consume('}'))
+    {
+        return true;
+    }
+
+    bool inParallel = size.isEmpty() || (qint64)size.width() * size.height() * MAX_PIXEL_TEXT <= WINDOW_BYTES;
+    int threads = std::max(1, QThreadPool::globalInstance()->maxThreadCount());
+    QList<FrameText> pending;
+    qint64 pendingBytes = 0;
+    QByteArray key;
+    do
+    {
+        if (!json.readString(key) || !json.consume(':'))
+        {
+            return false;
+        }
+        bool isFrame = false;
+        int index = key.startsWith("frame") ? key.mid(5).toInt(&isFrame) : -1;
+        if (isFrame && index >= 0 && inParallel)
+        {
+            FrameText frame;
+            frame.index = index;
+            if (!json.readRawValue(frame.text))
+            {
+                return false;
+            }
+            pendingBytes += frame.text.size();
+            pending.append(std::move(frame));
+            if (pending.size() >= threads || pendingBytes >= WINDOW_BYTES)
+            {
+                if (!parseFrames(pending, size, frames))
+                {
+                    return false;
+                }
+                pendingBytes = 0;
+            }
+        }
+        else if (isFrame && index >= 0)
+        {
+            if (!readFrame(json, size, frames[index]))
+            {
+                return false;
+            }
+        }
+        else if (!json.skipValue())
+        {
+            return false;
+        }
+    } while (json.consume(','));
+    return json.consume('}') && parseFrames(pending, size, frames);
+}
+
+///
+/// \brief LegacySpriteFile::read read a snapshot in the JSON format, either version. The keys may come in any order;
+///        files Qt wrote have the frames before the size, which costs keeping one frame's rows until it ends.
+/// \param device open, readable device positioned at the start of the file
+/// \param snapshot filled with the animation
+/// \param error set to a message for the user if reading fails
+/// \return true if read successfully
+///
+bool LegacySpriteFile::read(QIODevice *device, AnimationSnapshot &snapshot, QString *error)
+{
+    JsonTokenizer json(device);
+    if (!json.consume('{'))
+    {
+        setError(error, "This is not a sprite file.");
+        return false;
+    }
+
+    double version = 1;
+    double width = 0;
+    double height = 0;
+    double frameCount = 0;
+    std::map<int, QImage> frames;
+    bool ok = true;
+    if (!json.consume('}'))
+    {
+        QByteArray key;
+        do
+        {
+            ok = json.readString(key) && json.consume(':');
+            if (!ok)
+            {
+                break;
+            }
+
+            if (key == "version")
+            {
+                ok = json.readNumber(version);
+                if (ok && version > VERSION)
+                {
+                    setError(error, "The sprite was saved by a newer version of the editor.");
+                    return false;
+                }
+            }
+            else if (key == "width")
+            {
+                ok = json.readNumber(width);
+            }
+            else if (key == "height")
+            {
+                ok = json.readNumber(height);
+            }
+            else if (key == "numberOfFrames")
+            {
+                ok = json.readNumber(frameCount);
+            }
+            else if (key == "frames")
+            {
+                bool sizeKnown = width >= 1 && height >= 1 && width <= SpriteFile::MAX_FRAME_SIDE && height <= SpriteFile::MAX_FRAME_SIDE;
+                ok = readFrames(json, sizeKnown ? QSize(width, height) : QSize(), frames);
+            }
+            else
+            {
+                ok = json.skipValue();
+            }
+        } while (ok && json.consume(','));
+        ok = ok && json.consume('}');
+    }
+    if (!ok)
+    {
+        setError(error, "The sprite is damaged.");
+        return false;
+    }
+
+    if (width < 1 || height < 1 || width > SpriteFile::MAX_FRAME_SIDE || height > SpriteFile::MAX_FRAME_SIDE || frameCount < 1)
+    {
+        setError(error, "The sprite's size is damaged.");
+        return false;
+    }
+    if (frameCount > frames.size())
+    {
+        setError(error, "A frame is missing.");
+        return false;
+    }
+
+    AnimationSnapshot loaded;
+    loaded.frameSize = QSize(width, height);
+    for (int i = 0; i < (int)frameCount; i++)
+    {
+        auto frame = frames.find(i);
+        if (frame == frames.end())
+        {
+            setError(error, "A frame is missing.");
+            return false;
+        }
+        loaded.frames.push_back(SpriteFile::fitToSize(frame->second, loaded.frameSize));
+        frames.erase(frame);
+    }
+
+    snapshot = std::move(loaded);
+    return true;
+}
+
+///
+/// \brief appendChannel append a color channel as decimal text
+/// \param text where to append it
+/// \param value the channel, from 0 to 255
+///
+static void appendChannel(QByteArray &text, int value)
+{
+    if (value >= 100)
+    {
+        text.append(char('0' + value / 100));
+    }
+    if (value >= 10)
+    {
+        text.append(char('0' + value / 10 % 10));
+    }
+    text.append(char('0' + value % 10));
+}
+
+///
+/// \brief appendArrayRow append a row as an array of [r, g, b, a] arrays (version 1)
+/// \param text where to append it
+/// \param row the row's pixels
+/// \param width number of pixels in the row
+///
+static void appendArrayRow(QByteArray &text, const QRgb *row, int width)
+{
+    text += '[';
+    for (int x = 0; x < width; x++)
+    {
+        text += x == 0 ? "[" : ",[";
+        appendChannel(text, qRed(row[x]));
+        text += ',';
+        appendChannel(text, qGreen(row[x]));
+        text += ',';
+        appendChannel(text, qBlue(row[x]));
+        text += ',';
+        appendChannel(text, qAlpha(row[x]));
+        text += ']';
+    }
+    text += ']';
+}
+
+///
+/// \brief appendBase64Row append a row as a base64 string of little endian ARGB32 values (version 2)
+/// \param text where to append it
+/// \param row the row's pixels
+/// \param width number of pixels in the row
+/// \param packed scratch space, kept between rows
+///
+static void appendBase64Row(QByteArray &text, const QRgb *row, int width, QByteArray &packed)
+{
+    packed.resize(width * sizeof(QRgb));
+    qToLittleEndian<quint32>(row, width, packed.data());
+    text += '"';
+    text += packed.toBase64();
+    text += '"';
+}
+
+///
+/// \brief encodeFrame write one frame's key and rows as text
+/// \param canvas the frame
+/// \param index the frame's number
+/// \param rows how to write the rows
+/// \return the text, starting with the comma that separates it from the frame before, if there is one
+///
+static QByteArray encodeFrame(const QImage &canvas, int index, LegacySpriteFile::RowEncoding rows)
+{
+    QImage image = canvas.format() == QImage::Format_ARGB32 ? canvas : canvas.convertToFormat(QImage::Format_ARGB32);
+    QByteArray text = (index == 0 ? "\"frame" : ",\"frame") + QByteArray::number(index) + "\":[";
+    QByteArray packed;
+    for (int y = 0; y < image.height(); y++)
+    {
+        const QRgb *row = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        if (y != 0)
+        {
+            text += ',';
+        }
+        if (rows == LegacySpriteFile::RowEncoding::Base64)
+        {
+            appendBase64Row(text, row, image.width(), packed);
+        }
+        else
+        {
+            appendArrayRow(text, row, image.width());
+        }
+    }
+    text += ']';
+    return text;
+}
+
+///
+/// \brief LegacySpriteFile::write write a snapshot in the JSON format. Frames are encoded on the thread pool a few
+///        at a time, holding at most about WINDOW_BYTES of their text (or one frame's, if a frame is larger than
+///        that), and written in order. The size is written before the frames, so read() can put each row straight
+///        into its frame.
+/// \param device open, writable device
+/// \param snapshot the animation to write; every frame must have its pixels
+/// \param error set to a message for the user if writing fails
+/// \param rows how to write the rows; RowEncoding::Arrays writes version 1, for tools that only read that
+/// \return true if written successfully
+///
+bool LegacySpriteFile::write(QIODevice *device, const AnimationSnapshot &snapshot, QString *error, RowEncoding rows)
+{
+    QByteArray text = "{";
+    if (rows == RowEncoding::Base64)
+    {
+        // version 1 files have no version key
+        text += "\"version\":" + QByteArray::number(VERSION) + ",";
+    }
+    text += "\"height\":" + QByteArray::number(snapshot.frameSize.height())
+            + ",\"width\":" + QByteArray::number(snapshot.frameSize.width())
+            + ",\"numberOfFrames\":" + QByteArray::number((qulonglong)snapshot.frames.size())
+            + ",\"frames\":{";
+    bool ok = device->write(text) == text.size();
+
+    qint64 frameBytes = std::max<qint64>(1, (qint64)snapshot.frameSize.width() * snapshot.frameSize.height() * MAX_PIXEL_TEXT);
+    int threads = std::max(1, QThreadPool::globalInstance()->maxThreadCount());
+    int window = (int)std::clamp<qint64>(WINDOW_BYTES / frameBytes, 1, threads);
+    auto encode = [&snapshot, rows](int f)
+    {
+        return encodeFrame(snapshot.frames[f], f, rows);
+    };
+    for (int first = 0; first < (int)snapshot.frames.size() && ok; first += window)
+    {
+        QList<int> indices;
+        for (int f = first; f < std::min<int>(first + window, snapshot.frames.size()); f++)
+        {
+            indices.append(f);
+        }
+        QList<QByteArray> encoded = QtConcurrent::blockingMapped<QList<QByteArray>>(indices, encode);
+        for (int k = 0; k < encoded.size() && ok; k++)
+        {
+            ok = device->write(encoded[k]) == encoded[k].size();
+        }
+    }
+
+    text = "}}";
+    ok = ok && device->write(text) == text.size();
+    if (!ok)
+    {
+        setError(error, device->errorString());
+    }
+    return ok;
+}
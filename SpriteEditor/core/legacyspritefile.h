@@ -0,0 +1,33 @@
+#ifndef LEGACYSPRITEFILE_H
+#define LEGACYSPRITEFILE_H
+
+#include "animationsnapshot.h"
+#include <QIODevice>
+#include <QString>
+
+///
+/// \brief The LegacySpriteFile class reads and writes the older JSON .ssp format, kept for exchanging sprites with
+///        other tools:
+///          {"version": 2, "height": h, "width": w, "numberOfFrames": n,
+///           "frames": {"frame0": ["row 0", "row 1", ...one per row], "frame1": ...}}
+///        where each row is a base64 string of the row's pixels as little endian ARGB32 values, as in the binary
+///        format. Version 1 files have no "version" key and hold each row as an array of [r, g, b, a] arrays, one
+///        per column, which takes about four times the space and far longer to parse. Both are read; each row's
+///        form is told from its first character.
+///        Both directions stream, encoding or parsing a window of frames on the thread pool at a time, so besides
+///        the frames themselves memory is bounded by the window (about 64 MB of text, or one frame's if a frame
+///        is larger) however large the file is.
+///
+class LegacySpriteFile
+{
+public:
+    static constexpr int VERSION = 2;
+
+    enum class RowEncoding { Arrays, Base64 };
+
+    static bool write(QIODevice *device, const AnimationSnapshot &snapshot, QString *error = nullptr,
+                      RowEncoding rows = RowEncoding::Base64);
+    static bool read(QIODevice *device, AnimationSnapshot &snapshot, QString *error = nullptr);
+};
+
+#endif // LEGACYSPRITEFILE_H
@@ -0,0 +1,831 @@
+// Code style reviewed by Nickolas Solum on 4/5/2023
+#include "model.h"
+#include "legacyspritefile.h"
+#include "spritefile.h"
+#include "spritefilereader.h"
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtConcurrent>
+
+///
+/// \brief Model::Model constructor.
+/// \param parent used by Qt
+///
+Model::Model(QObject *parent)
+    : QObject(parent),
+      sprite(new Animation())
+{
+    paintSettings = Paint();
+    currentTool = std::make_unique<Paintbrush>();
+
+    connect(&sprite,
+            &Animation::pushUndoState,
+            this,
+            &Model::pushUndoState);
+
+    connect(&undoHistory,
+            &UndoHistory::memoryUsageChanged,
+            this,
+            &Model::undoMemoryUsageChanged);
+
+    //Reordering frames by dragging them doesn't push an undo state, but it is still an edit autosave has to write
+    connect(&sprite,
+            &QAbstractItemModel::rowsMoved,
+            this,
+            [this] { editCount++; });
+
+    connect(&sprite,
+            &Animation::frameDamaged,
+            this,
+            &Model::frameDamaged);
+
+    connect(&undoHistory,
+            &UndoHistory::restoreFailed,
+            this,
+            [this](const QString &error) { emit showWarning("Unable to undo", error); });
+
+    //Animates frames shown in animation preview. See playAnimation()
+    connect(timer, &QTimer::timeout, [this]()
+    {
+        //change to next frame.
+        sprite.changeFrameWhenAnimating(animationFramesIndex);
+
+        //increment so can change to next frame. If at last frame, start from beginning
+        if(animationFramesIndex < sprite.getSizeOfFramesVector()-1)
+        {
+            animationFramesIndex++;
+        }
+        else
+        {
+            animationFramesIndex = 0;
+        }
+        emit updateFramePicker(animationFramesIndex);
+    });
+
+    connect(&saveWatcher,
+            &QFutureWatcher<SaveResult>::finished,
+            this,
+            &Model::saveFinished);
+
+    connect(&autosaveTimer,
+            &QTimer::timeout,
+            this,
+            &Model::autosave);
+
+    connect(&exportWatcher,
+            &QFutureWatcher<QString>::finished,
+            this,
+            &Model::exportFinished);
+    setAutosaveInterval(5);
+}
+
+///
+/// \brief Model::~Model destructor. Waits for a save or export in progress, so quitting never loses one.
+///
+Model::~Model()
+{
+    exportWatcher.waitForFinished();
+    saveWatcher.waitForFinished();
+    if(queuedSave && !queuedSave->autosave)
+        writeSnapshot(*queuedSave, sprite.snapshot());
+}
+
+
+///
+/// \brief Model::brushSelectedState Select the brush tool
+/// \return true
+///
+bool Model::brushSelectedState()
+{
+    currentTool = std::make_unique<Paintbrush>();
+    return true;
+}
+
+///
+/// \brief Model::onionSkinningSelectedState Toggle onion skinning
+/// \return current state of onion skinning, true iff selected
+///
+bool Model::onionSkinningSelectedState()
+{
+    onionSkinningSelected = !onionSkinningSelected;
+    sprite.getCurFrame()->afterCanvasChanged();
+    return onionSkinningSelected;
+}
+
+///
+/// \brief Model::dithererSelectedState Toggle dithering feature
+/// \return current state of dithering, true iff selected
+///
+bool Model::dithererSelectedState()
+{
+    return paintSettings.switchDithering();
+}
+
+///
+/// \brief Model::paintBucketSelectedState Select the paint bucket tool
+/// \return true
+///
+bool Model::paintBucketSelectedState()
+{
+    currentTool = std::make_unique<PaintBucket>();
+    return true;
+}
+
+///
+/// \brief Model::eraserSelectedState Select the eraser tool
+/// \return true
+///
+bool Model::eraserSelectedState()
+{
+    currentTool = std::make_unique<Eraser>();
+    return true;
+}
+
+///
+/// \brief Model::brushSizeValueChanged Set the brush size
+/// \param value size to set the tool as.
+///
+void Model::brushSizeValueChanged(int size)
+{
+    paintSettings.setToolSize(size);
+}
+
+///
+/// \brief Model::ditherPatternChanged Set the pattern used while dithering
+/// \param index index into DitherPattern::typeNames()
+///
+void Model::ditherPatternChanged(int index)
+{
+    paintSettings.setDitherType(static_cast<DitherPattern::Type>(index));
+}
+
+///
+/// \brief Model::ditherPercentChanged Set how much of the dither pattern uses the secondary color
+/// \param percent 0 to 100
+///
+void Model::ditherPercentChanged(int percent)
+{
+    paintSettings.setDitherPercent(percent);
+}
+
+///
+/// \brief Model::mouseClicked Slot that is called when the mouse is clicked on the frame
+/// \param x - the x coordinate to draw the pixel on
+/// \param y - the y coordinate to draw the pixel on
+///
+void Model::mouseClicked(int x, int y)
+{
+    endStroke();
+    strokeFrame = sprite.getCurFrame();
+    strokeFrame->beginTransaction();
+    currentTool->useToolAtPoint(strokeFrame, paintSettings, x, y);
+}
+
+///
+/// \brief Model::mouseMoved Slot that is called with the path the mouse has moved along on the frame since the
+///        last call. The whole path is drawn in one pass.
+/// \param path - pixel coordinates, starting from where the previous path (or the click) ended
+///
+void Model::mouseMoved(const QPolygon &path)
+{
+    // the stroke stays on the frame it started on, even if another frame is selected meanwhile; moves that aren't
+    // part of a stroke (such as after undo or redo ended it) draw nothing
+    if(!strokeFrame)
+        return;
+
+    currentTool->useToolOnPolyline(strokeFrame, paintSettings, path);
+}
+
+///
+/// \brief Model::mouseReleased Slot that is called when the mouse is released; the stroke becomes one undo state
+///
+void Model::mouseReleased()
+{
+    endStroke();
+}
+
+///
+/// \brief Model::endStroke commit the stroke in progress, if any
+///
+void Model::endStroke()
+{
+    if(strokeFrame)
+    {
+        strokeFrame->commitTransaction();
+        strokeFrame.reset();
+    }
+}
+
+
+///
+/// \brief Model::getOnionSkinningSelected Return state of onion skinning selection
+/// \return  true iff onion skinning is enabled
+///
+bool Model::getOnionSkinningSelected()
+{
+    return onionSkinningSelected;
+}
+
+///
+/// \brief Model::getCurrentFile
+/// \return the file "Save" writes to, or tr("") if the sprite hasn't been loaded or saved yet
+///
+QString Model::getCurrentFile()
+{
+    return currentFile;
+}
+
+///
+/// \brief Model::save serialize to the currently-open file. Does nothing if there isn't one; use saveAs then.
+///
+void Model::save()
+{
+    if(currentFile == tr(""))
+        return;
+
+    startSave({currentFile, currentFormat, false});
+}
+
+///
+/// \brief Model::saveAs serialize to a file, which "Save" writes to from then on
+/// \param filename file to write
+/// \param format format to write it in
+///
+void Model::saveAs(const QString &filename, FileFormat format)
+{
+    currentFile = filename;
+    currentFormat = format;
+
+    startSave({currentFile, currentFormat, false});
+}
+
+///
+/// \brief Model::startSave write the animation to a file on a background thread, so editing can continue while
+///        it is written. Taking the snapshot is cheap: it shares the frames' pixels, and a frame is only copied if
+///        it is edited before the write finishes.
+///
+///        A binary file this sprite was loaded from or saved to only gets the frames that changed since then added
+///        to it, until most of it is frames that aren't used any more; then it is written from scratch to compact it.
+/// \param request where and how to write; waits for the save being written, if there is one
+///
+void Model::startSave(const SaveRequest &request)
+{
+    if(saveWatcher.isRunning())
+    {
+        // a later save writes everything the earlier one would have, so only the newest has to wait
+        queuedSave = request;
+        return;
+    }
+
+    runningSave = request;
+    savingEditCount = editCount;
+
+    // compacting writes every frame anew, which would replace a damaged frame's data with the empty canvas shown for it
+    auto known = layouts.constFind(request.filename);
+    if(request.format == FileFormat::Binary && known != layouts.cend()
+       && (!SpriteFile::shouldCompact(*known) || sprite.hasDamagedFrames()))
+        runningSave.layout = *known;
+    else
+        runningSave.layout.reset();
+
+    // frames of a lazily loaded file that haven't been decoded yet are decoded by writeSnapshot on the worker thread
+    AnimationSnapshot snapshot;
+    if(!runningSave.layout && request.filename == mappedFile)
+    {
+        // the file is about to be replaced while it is still mapped, which fails on some systems, so decode every
+        // frame now; that lets go of the reader (once an export that might be using it is done)
+        snapshot = sprite.snapshot();
+        exportWatcher.waitForFinished();
+        mappedFile.clear();
+    }
+    else if(runningSave.layout)
+    {
+        // frames the file already holds aren't needed, nor decoded if they were loaded lazily
+        const SpriteFile::Layout &layout = *runningSave.layout;
+        snapshot = sprite.snapshot([&layout](quint64 revision) { return layout.blocks.count(revision) > 0; }, true);
+    }
+    else
+    {
+        snapshot = sprite.snapshot(nullptr, true);
+    }
+    saveWatcher.setFuture(QtConcurrent::run(&Model::writeSnapshot, runningSave, std::move(snapshot)));
+}
+
+///
+/// \brief Model::saveFinished report how the background save went, and start the one waiting for it, if any
+///
+void Model::saveFinished()
+{
+    SaveResult result = saveWatcher.result();
+    if(result.retryInFull)
+    {
+        SaveRequest retry = runningSave;
+        layouts.remove(retry.filename);
+        startSave(retry);
+        return;
+    }
+
+    QString error = result.error;
+    if(result.layout)
+        layouts[runningSave.filename] = *result.layout;
+    else
+        layouts.remove(runningSave.filename);
+
+    if(!error.isEmpty())
+    {
+        // autosave runs again at the next interval, so don't interrupt the user with a dialog for it
+        if(runningSave.autosave)
+            emit showStatus("Unable to autosave. " + error);
+        else
+            emit showWarning("Unable to write file", "Sprite is not saved. " + error);
+    }
+    else
+    {
+        savedEditCount = savingEditCount;
+        if(runningSave.autosave)
+        {
+            emit showStatus("Autosaved to " + QDir::toNativeSeparators(runningSave.filename));
+        }
+        else
+        {
+            // the file is newer than its autosave now
+            QFile::remove(autosaveLocation(runningSave.filename));
+            layouts.remove(autosaveLocation(runningSave.filename));
+            emit showStatus("Saved to " + QDir::toNativeSeparators(runningSave.filename));
+        }
+    }
+
+    if(queuedSave)
+    {
+        SaveRequest next = *queuedSave;
+        queuedSave.reset();
+        startSave(next);
+    }
+}
+
+///
+/// \brief Model::autosave write the animation next to its file (or to the app's data folder if it has never been
+///        saved) if it has changed since it was last written
+///
+void Model::autosave()
+{
+    // mid-stroke the frame is only partly drawn, and a busy writer would just delay this; try at the next interval
+    if(editCount == savedEditCount || strokeFrame || saveWatcher.isRunning())
+        return;
+
+    startSave({autosaveLocation(currentFile), FileFormat::Binary, true});
+}
+
+///
+/// \brief Model::autosaveLocation
+/// \param filename file the sprite is saved to, or empty if it hasn't been saved
+/// \return file to autosave the sprite to
+///
+QString Model::autosaveLocation(const QString &filename)
+{
+    if(filename.isEmpty())
+    {
+        QDir dataDir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation));
+        dataDir.mkpath(".");
+        return dataDir.filePath("untitled.autosave.ssp");
+    }
+
+    QFileInfo file(filename);
+    return file.dir().filePath(file.completeBaseName() + ".autosave.ssp");
+}
+
+///
+/// \brief Model::writeSnapshot serialize a snapshot to a file. Safe to call from any thread.
+/// \param request the file to write and its format
+/// \param snapshot the animation to write; frames it leaves to its loaders are decoded first
+/// \return how it went
+///
+Model::SaveResult Model::writeSnapshot(const SaveRequest &request, AnimationSnapshot snapshot)
+{
+    SaveResult result;
+    if(!snapshot.decodeFrames(&result.error))
+        return result;
+
+    if(request.layout)
+    {
+        QFile file(request.filename);
+        SpriteFile::Layout layout = *request.layout;
+        if(!file.open(QIODevice::ReadWrite) || !SpriteFile::append(&file, snapshot, layout) || !file.flush())
+        {
+            // the file isn't what it was when it was last written; the snapshot lacks the frames it held
+            result.retryInFull = true;
+            return result;
+        }
+        result.layout = std::move(layout);
+        return result;
+    }
+
+    // QSaveFile writes to a temporary file and only replaces the target on commit, so a failed write never
+    // leaves a half-written sprite behind
+    QSaveFile saveFile(request.filename);
+
+    if(!saveFile.open(QIODevice::WriteOnly))
+    {
+        result.error = "Unable to open file for writing.";
+        return result;
+    }
+
+    SpriteFile::Layout layout;
+    if(request.format == FileFormat::LegacyJson)
+    {
+        if(!LegacySpriteFile::write(&saveFile, snapshot, &result.error))
+            return result;
+    }
+    else if(!SpriteFile::write(&saveFile, snapshot, &result.error, &layout))
+    {
+        return result;
+    }
+
+    if(!saveFile.commit())
+    {
+        result.error = saveFile.errorString();
+        return result;
+    }
+    if(request.format == FileFormat::Binary)
+        result.layout = std::move(layout);
+    return result;
+}
+
+///
+/// \brief Model::getAutosaveInterval
+/// \return minutes between autosaves, or 0 if autosave is off
+///
+int Model::getAutosaveInterval()
+{
+    return autosaveTimer.isActive() ? autosaveTimer.interval() / 60000 : 0;
+}
+
+///
+/// \brief Model::setAutosaveInterval set how often the animation is autosaved
+/// \param minutes minutes between autosaves; 0 turns autosave off
+///
+void Model::setAutosaveInterval(int minutes)
+{
+    if(minutes <= 0)
+    {
+        autosaveTimer.stop();
+        return;
+    }
+    autosaveTimer.start(minutes * 60000);
+}
+
+///
+/// \brief Model::exportSpriteSheet write every frame to one PNG, and its metadata if asked for, on a background
+///        thread; showStatus or showWarning is emitted when it is done
+/// \param filename the image file to write
+/// \param options the sheet's layout, and which metadata to write
+///
+void Model::exportSpriteSheet(const QString &filename, const SpriteSheet::Options &options)
+{
+    if(exportWatcher.isRunning())
+    {
+        emit showWarning("Unable to export", "The last sprite sheet is still being exported.");
+        return;
+    }
+
+    exportingFile = filename;
+    // the snapshot shares the frames' pixels, so this is cheap; decoding frames that were loaded lazily, composing
+    // and compressing all happen on the thread pool
+    AnimationSnapshot snapshot = sprite.snapshot(nullptr, true);
+    exportWatcher.setFuture(QtConcurrent::run([filename, options, snapshot]() mutable
+    {
+        QString error;
+        if(!snapshot.decodeFrames(&error))
+            return error;
+        if(!SpriteSheet::write(filename, snapshot, options, &error) && error.isEmpty())
+            error = "Unable to write file.";
+        return error;
+    }));
+    emit showStatus("Exporting to " + QDir::toNativeSeparators(filename) + "...");
+}
+
+///
+/// \brief Model::exportFinished report how the sprite sheet export went
+///
+void Model::exportFinished()
+{
+    QString error = exportWatcher.result();
+    if(!error.isEmpty())
+        emit showWarning("Unable to export", "Sprite sheet is not exported. " + error);
+    else
+        emit showStatus("Exported to " + QDir::toNativeSeparators(exportingFile));
+}
+
+///
+/// \brief Model::load deserialize from file. Both the binary and the older JSON format are read.
+/// \param openFilename file to read
+/// \return true if the sprite was loaded; otherwise showWarning has been emitted and the sprite is unchanged
+///
+bool Model::load(const QString &openFilename)
+{
+    QFile openFile(openFilename);
+
+    if(!openFile.open(QIODevice::ReadOnly))
+    {
+        emit showWarning("Unable to open file", "Unable to open file for reading. Cannot open sprite.");
+        return false;
+    }
+
+    if(SpriteFile::isSpriteFile(&openFile))
+    {
+        QString error;
+        // Map the file and decode frames as they are shown; the reader lives until every frame has been decoded or discarded
+        if(std::shared_ptr<SpriteFileReader> reader = SpriteFileReader::open(openFilename, &error))
+        {
+            sprite.restoreLazily(reader->getFrameSize(), reader->getFrameCount(),
+                                 [reader](int index) { return reader->decodeFrame(index); });
+            layouts[openFilename] = reader->layoutFor(sprite.frameRevisions());
+            mappedFile = openFilename;
+        }
+        else
+        {
+            // the file could not be mapped (or is damaged); read it the ordinary way, which also reports damage
+            AnimationSnapshot loaded;
+            if(!SpriteFile::read(&openFile, loaded, &error))
+            {
+                emit showWarning("Unable to open file", "Cannot open sprite. " + error);
+                return false;
+            }
+            sprite.restore(loaded);
+            // what is known of the file's layout may be from before something else rewrote it
+            layouts.remove(openFilename);
+            mappedFile.clear();
+        }
+        currentFormat = FileFormat::Binary;
+    }
+    else
+    {
+        // parsed as it is read, so the text is never held in memory all at once
+        AnimationSnapshot loaded;
+        QString error;
+        if(!LegacySpriteFile::read(&openFile, loaded, &error))
+        {
+            emit showWarning("Unable to open file", "Cannot open sprite. " + error);
+            return false;
+        }
+        sprite.restore(loaded);
+        layouts.remove(openFilename);
+        mappedFile.clear();
+        // keep saving it the way it was written, so other tools can still read it
+        currentFormat = FileFormat::LegacyJson;
+    }
+
+    currentFile = openFilename;
+    savedEditCount = editCount;
+    purgeUndo();
+    return true;
+}
+
+///
+/// \brief Model::frameDamaged warn that a lazily loaded frame couldn't be decoded. Frames are decoded while the
+///        view is painting, so the warning waits for the event loop, and frames found damaged meanwhile share it.
+/// \param index the frame
+///
+void Model::frameDamaged(int index)
+{
+    Q_UNUSED(index);
+    if(damagedFrames++ > 0)
+        return;
+
+    QTimer::singleShot(0, this, [this]
+    {
+        emit showWarning("Damaged frames",
+                         QString::number(damagedFrames) + " frame(s) of this sprite could not be read and are shown "
+                         "empty. Saving to the same file keeps their data there unless they are drawn on.");
+        damagedFrames = 0;
+    });
+}
+
+///
+/// \brief Model::addFrameToList add new frame to end of the list
+///
+void Model::addFrameToList()
+{
+    sprite.addFrame(sprite.getFrameSize());
+}
+
+///
+/// \brief Model::deleteFrameFromList delete current frame
+///
+void Model::deleteFrameFromList()
+{
+    sprite.deleteFrame(sprite.getCurrFrameIndex());
+}
+
+///
+/// \brief Model::frameClicked when click the frame in the QViewlist, set it to be current frame
+/// \param index frame index selected
+///
+void Model::frameClicked(const QModelIndex &index)
+{
+    sprite.changeFrame(index.row());
+}
+
+///
+/// \brief Model::pushUndoState after the user does something, save the change so it can be undone
+/// \param s UndoState representing the user's change
+///
+void Model::pushUndoState(UndoState state)
+{
+    // Removes all redo states
+    undoHistory.push(std::move(state));
+    editCount++;
+
+    emit updateUndoDisabled(getUndoDisabled());
+    emit updateRedoDisabled(getRedoDisabled());
+}
+
+///
+/// \brief Model::purgeUndo throw away all undo data (e.g. for after a new file is loaded)
+///
+void Model::purgeUndo()
+{
+    undoHistory.clear();
+
+    emit updateUndoDisabled(getUndoDisabled());
+    emit updateRedoDisabled(getRedoDisabled());
+}
+
+///
+/// \brief Model::getUndoDisabled
+/// \return true if the Undo menu option should be disabled
+///
+bool Model::getUndoDisabled()
+{
+    return !undoHistory.canUndo();
+}
+
+///
+/// \brief Model::getRedoDisabled
+/// \return true if the Redo menu option should be disabled
+///
+bool Model::getRedoDisabled()
+{
+    return !undoHistory.canRedo();
+}
+
+///
+/// \brief Model::getUndoMemoryUsage
+/// \return bytes of memory currently used by the undo history
+///
+qint64 Model::getUndoMemoryUsage()
+{
+    return undoHistory.getMemoryUsage();
+}
+
+///
+/// \brief Model::setUndoByteBudget limit the memory used by the undo history; older states beyond it are kept on disk
+/// \param bytes the budget
+///
+void Model::setUndoByteBudget(qint64 bytes)
+{
+    undoHistory.setByteBudget(bytes);
+}
+
+///
+/// \brief Model::undo slot to undo the most recent change
+///
+void Model::undo()
+{
+    endStroke();
+    if(!undoHistory.canUndo())
+        return;
+
+    // undo the most recent change
+    std::optional<UndoState> restored = undoHistory.undo();
+    if(!restored)
+        return;
+    const UndoState &state = *restored;
+    editCount++;
+    switch(state.type)
+    {
+        case UndoStateType::FRAME_CHANGE:
+            sprite.replaceFrame(state.frame_start_index, std::make_shared<Frame>(*state.old_frame), false);
+            break;
+        case UndoStateType::FRAME_ADD:
+            sprite.deleteFrame(state.frame_start_index, false);
+            break;
+        case UndoStateType::FRAME_DELETE:
+            sprite.insertFrame(state.frame_start_index, std::make_shared<Frame>(*state.old_frame), false);
+            break;
+        case UndoStateType::FRAME_REINSERT:
+            break;
+        case UndoStateType::REGION_CHANGE:
+            sprite.patchFrame(state.frame_start_index, state.region, state.old_pixels);
+            break;
+    }
+    emit updateUndoDisabled(getUndoDisabled());
+    emit updateRedoDisabled(getRedoDisabled());
+}
+
+///
+/// \brief Model::redo slot to redo the most recent change
+///
+void Model::redo()
+{
+    endStroke();
+    if(!undoHistory.canRedo())
+        return;
+
+    // redo the next change
+    std::optional<UndoState> restored = undoHistory.redo();
+    if(!restored)
+        return;
+    const UndoState &s = *restored;
+    editCount++;
+    switch(s.type)
+    {
+        case UndoStateType::FRAME_CHANGE:
+            sprite.replaceFrame(s.frame_start_index, std::make_shared<Frame>(*s.new_frame), false);
+            break;
+        case UndoStateType::FRAME_ADD:
+            sprite.insertFrame(s.frame_start_index, std::make_shared<Frame>(*s.new_frame), false);
+            break;
+        case UndoStateType::FRAME_DELETE:
+            sprite.deleteFrame(s.frame_start_index, false);
+            break;
+        case UndoStateType::FRAME_REINSERT:
+            break;
+        case UndoStateType::REGION_CHANGE:
+            sprite.patchFrame(s.frame_start_index, s.region, s.new_pixels);
+            break;
+    }
+
+    emit updateUndoDisabled(getUndoDisabled());
+    emit updateRedoDisabled(getRedoDisabled());
+}
+
+///
+/// \brief Model::copyFrame copy the current frame
+///
+void Model::copyFrame()
+{
+     int index = sprite.getCurrFrameIndex();
+     sprite.copyFrame(index);
+}
+
+///
+/// \brief Model::playAnimation helper for animation preview
+/// \param fps frames per second
+///
+void Model::playAnimation(int fps)
+{
+    if(fps > 0)
+    {
+        //start at frame zero when new fps slider value is changed
+        animationFramesIndex = 0;
+        sprite.changeFrameWhenAnimating(animationFramesIndex);
+
+        // Calculates interval between frames
+        int interval = 1000 / fps;
+
+        timer->setInterval(interval);
+
+        timer->start();
+    }
+    else
+    {
+        //stop animation if fps is zero
+        timer->stop();
+    }
+}
+
+
+///
+/// \brief Model::changeFrameShown Slider to change frame in animation preview
+/// \param number of frame to show
+///
+void Model::changeFrameShown(int frame)
+{
+    if(sprite.getSizeOfFramesVector() >= 1)
+    {
+        emit numOfMadeFrames(sprite.getSizeOfFramesVector()-1);
+        sprite.changeFrameWhenAnimating(frame);
+    }
+}
+
+///
+/// \brief Model::stopTimer Stop animation so that it doesn't affect pixel editor
+///
+void Model::stopTimer()
+{
+    timer->stop();
+    //reset to shwoing frame 0 in animation preview when close window and open it back up.
+    changeFrameShown(0);
+}
+
+///
+/// \brief Model::setStartingAnimationFrame show the first frame
+///
+void Model::setStartingAnimationFrame()
+{
+    changeFrameShown(0);
+}
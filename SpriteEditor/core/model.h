@@ -0,0 +1,184 @@
+// Code style reviewed by Nickolas Solum on 4/5/2023
+#ifndef MODEL_H
+#define MODEL_H
+
+#include "animation.h"
+#include "eraser.h"
+#include "frame.h"
+#include <memory>
+#include <optional>
+#include "paint.h"
+#include "paintbrush.h"
+#include "paintbucket.h"
+#include "spritefile.h"
+#include "spritesheet.h"
+#include "tool.h"
+#include "undohistory.h"
+#include "undostate.h"
+#include <QFutureWatcher>
+#include <QHash>
+#include <QModelIndex>
+#include <QPolygon>
+#include <QString>
+#include <QTimer>
+
+///
+/// \brief The Model class hold the state of the sprite editor and contains much of the code to manipulate that state.
+///        It uses no widgets, so it can run without a display; picking files and showing messages is up to the view.
+/// \author Ayden Smith, Kyle Holland, Joey Cai, Cameron Wortmann
+///
+class Model : public QObject
+{
+    Q_OBJECT
+
+    std::unique_ptr<Tool> currentTool;
+
+    QColor getPrimaryColor();
+    QColor getSecondaryColor();
+    bool onionSkinningSelected = false;
+    bool dithererSelected = false;
+
+    UndoHistory undoHistory;
+
+    void purgeUndo();
+
+    // frame being drawn on between mouseClicked and mouseReleased
+    std::shared_ptr<Frame> strokeFrame;
+    void endStroke();
+
+    int animationFramesIndex = 0;
+
+public:
+    enum class FileFormat { Binary, LegacyJson };
+
+    Model(QObject *parent = nullptr);
+    ~Model();
+
+    Paint paintSettings;
+    Animation sprite;
+
+    //Animation spriteAnimation;
+
+    QString getCurrentFile();
+    bool getUndoDisabled();
+    bool getRedoDisabled();
+    qint64 getUndoMemoryUsage();
+    void setUndoByteBudget(qint64 bytes);
+    bool getOnionSkinningSelected();
+    int getAutosaveInterval();
+    void setAutosaveInterval(int minutes);
+    void exportSpriteSheet(const QString &filename, const SpriteSheet::Options &options);
+
+public slots:
+    bool brushSelectedState();
+    bool onionSkinningSelectedState();
+    bool dithererSelectedState();
+    bool paintBucketSelectedState();
+    bool eraserSelectedState();
+
+    void mouseClicked(int x, int y);
+    void mouseMoved(const QPolygon &path);
+    void mouseReleased();
+    void brushSizeValueChanged(int value);
+    void ditherPatternChanged(int index);
+    void ditherPercentChanged(int percent);
+
+    void addFrameToList();
+    void deleteFrameFromList();;
+    void frameClicked(const QModelIndex &index);
+    void copyFrame();
+
+    void save();
+    void saveAs(const QString &filename, FileFormat format);
+    bool load(const QString &filename);
+
+    void undo();
+    void redo();
+
+    void changeFrameShown(int frame);
+    void playAnimation(int fps);
+    void stopTimer();
+    void setStartingAnimationFrame();
+
+private slots:
+    void pushUndoState(UndoState s);
+    void frameDamaged(int index);
+
+signals:
+    void showWarning(const QString& title, const QString& text);
+    void showStatus(const QString& text);
+
+    void updateUndoDisabled(bool disabled);
+    void updateRedoDisabled(bool disabled);
+    void undoMemoryUsageChanged(qint64 bytes);
+
+    void numOfMadeFrames(int frames);
+    void updateFramePicker(int currFrame);
+
+
+private:
+    // "Save" will write to this file, if it's set, in this format
+    QString currentFile;
+    FileFormat currentFormat = FileFormat::Binary;
+
+    // a file to write in the background; see startSave
+    struct SaveRequest
+    {
+        QString filename;
+        FileFormat format;
+        bool autosave;
+        // what the file already holds, if only the changed frames need to be added to it
+        std::optional<SpriteFile::Layout> layout;
+    };
+
+    struct SaveResult
+    {
+        // a message for the user, or empty if the file was written
+        QString error;
+        // what the file holds now, if it is in the binary format
+        std::optional<SpriteFile::Layout> layout;
+        // the file couldn't be added to, so it has to be written from scratch
+        bool retryInFull = false;
+    };
+
+    void startSave(const SaveRequest &request);
+    void saveFinished();
+    void autosave();
+    static QString autosaveLocation(const QString &filename);
+    static SaveResult writeSnapshot(const SaveRequest &request, AnimationSnapshot snapshot);
+
+    // only one save is written at a time; a save asked for meanwhile waits in queuedSave
+    QFutureWatcher<SaveResult> saveWatcher;
+    SaveRequest runningSave;
+    std::optional<SaveRequest> queuedSave;
+
+    // what each binary file this sprite was loaded from or saved to holds, so saves only add the frames that changed
+    QHash<QString, SpriteFile::Layout> layouts;
+
+    // the file frames that haven't been decoded yet are read from, if the sprite was loaded lazily; it stays mapped
+    // until they all are
+    QString mappedFile;
+
+    // counts edits, so autosave can skip an animation that is already on disk
+    quint64 editCount = 0;
+    quint64 savingEditCount = 0;
+    quint64 savedEditCount = 0;
+
+    QTimer autosaveTimer;
+
+    // frames found damaged since the last warning about them
+    int damagedFrames = 0;
+
+    // sprite sheets are composed and compressed in the background, one at a time; the result is an error message
+    void exportFinished();
+    QFutureWatcher<QString> exportWatcher;
+    QString exportingFile;
+
+   // QTimer *timer;
+
+    QTimer* timer = new QTimer(this);
+
+
+};
+
+#endif // MODEL_H
@@ -0,0 +1,132 @@
+// Code style reviewed by Cameron Wortmann on 4/5/2023
+#include "paint.h"
+
+Paint::Paint()
+{
+    primaryColor = QColor(0, 0, 0, 255);
+    secondaryColor =  QColor(255, 255, 255, 255);
+    dithering = false;
+    toolSize = 1;
+    ditherType = DitherPattern::Type::Bayer2x2;
+    ditherPercent = 50;
+    customWidth = 1;
+    customHeight = 1;
+    customCells = {false};
+    updatePattern();
+}
+
+///
+/// \brief Paint::getToolSize Returns the size of the tool
+/// \return int toolSize
+///
+int Paint::getToolSize() const
+{
+    return toolSize;
+}
+
+///
+/// \brief Paint::setToolSize Sets the size of tool
+/// \param size toolSize
+///
+void Paint::setToolSize(int size)
+{
+    toolSize = size;
+}
+
+bool Paint::switchDithering()
+{
+    dithering = !dithering;
+    updatePattern();
+    return dithering;
+}
+
+bool Paint::getDithering() const
+{
+    return dithering;
+}
+
+QColor Paint::getPrimaryColor() const
+{
+    return primaryColor;
+
+}
+
+QColor Paint::getSecondaryColor() const
+{
+    return secondaryColor;
+}
+
+void Paint::setPrimaryColor(const QColor &primary)
+{
+    primaryColor = primary;
+    updatePattern();
+}
+void Paint::setSecondaryColor(const QColor &secondary)
+{
+    secondaryColor = secondary;
+    updatePattern();
+}
+
+///
+/// \brief Paint::setDitherType Choose the pattern used while dithering is on
+/// \param type the pattern
+///
+void Paint::setDitherType(DitherPattern::Type type)
+{
+    ditherType = type;
+    updatePattern();
+}
+
+///
+/// \brief Paint::setDitherPercent Choose how much of a Bayer pattern uses the secondary color
+/// \param percent 0 to 100
+///
+void Paint::setDitherPercent(int percent)
+{
+    ditherPercent = percent;
+    updatePattern();
+}
+
+///
+/// \brief Paint::setCustomDitherPattern Set the pattern used when the dither type is Custom
+/// \param width width of the repeating cell
+/// \param height height of the repeating cell
+/// \param secondaryCells width*height flags, row by row; true where the secondary color is used
+///
+void Paint::setCustomDitherPattern(int width, int height, const std::vector<bool> &secondaryCells)
+{
+    customWidth = width;
+    customHeight = height;
+    customCells = secondaryCells;
+    updatePattern();
+}
+
+///
+/// \brief Paint::getPattern Returns the precomputed pattern tools copy rows of pixels from.
+/// \return the dither pattern, or a solid primary color pattern if dithering is off
+///
+std::shared_ptr<const DitherPattern> Paint::getPattern() const
+{
+    return pattern;
+}
+
+///
+/// \brief Paint::updatePattern Rebuild the pattern after any color or dithering setting changes
+///
+void Paint::updatePattern()
+{
+    QRgb primary = primaryColor.rgba();
+    QRgb secondary = secondaryColor.rgba();
+    if (!dithering)
+    {
+        pattern = std::make_shared<const DitherPattern>(primary);
+    }
+    else if (ditherType == DitherPattern::Type::Custom)
+    {
+        pattern = std::make_shared<const DitherPattern>(customWidth, customHeight, customCells, primary, secondary);
+    }
+    else
+    {
+        pattern = std::make_shared<const DitherPattern>(ditherType, ditherPercent, primary, secondary);
+    }
+}
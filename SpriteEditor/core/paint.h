@@ -0,0 +1,49 @@
+#ifndef PAINT_H
+#define PAINT_H
+
+#include "ditherpattern.h"
+#include <memory>
+#include <QColor>
+
+///
+/// \brief The Paint class stores a set of drawing settings (colors and styles)
+/// \author Nickolas Solum
+///
+class Paint
+{
+private:
+    QColor primaryColor;
+    QColor secondaryColor;
+    bool dithering;
+    int toolSize;
+
+    DitherPattern::Type ditherType;
+    int ditherPercent;
+    int customWidth;
+    int customHeight;
+    std::vector<bool> customCells;
+
+    // what tools paint with: the dither pattern, or the solid primary color if dithering is off
+    std::shared_ptr<const DitherPattern> pattern;
+    void updatePattern();
+public:
+    Paint();
+
+    int getToolSize() const;
+    void setToolSize(int size);
+
+    bool switchDithering();
+    bool getDithering() const;
+    void setDitherType(DitherPattern::Type type);
+    void setDitherPercent(int percent);
+    void setCustomDitherPattern(int width, int height, const std::vector<bool> &secondaryCells);
+    std::shared_ptr<const DitherPattern> getPattern() const;
+
+    QColor getPrimaryColor() const;
+    QColor getSecondaryColor() const;
+
+    void setPrimaryColor(const QColor &primary);
+    void setSecondaryColor(const QColor &secondary);
+};
+
+#endif // PAINT_H
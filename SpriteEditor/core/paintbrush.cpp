@@ -0,0 +1,38 @@
+//Code style reviewed by Cameron Wortmann on 4/5/2023
+#include "paintbrush.h"
+
+///
+/// \brief Paintbrush::useToolAtPoint Uses paintbrush at point with coordinates (x,y) This colors the
+///        pixels within the tool to the colors specified in paintSettings, dithering if option is on.
+/// \param frame to use paintbrush on
+/// \param paintSettings Settings for the tool, including color, dithering, and tool size.
+/// \param x coordinate of base of paintbrush
+/// \param y coordinate of base of paintbrush
+///
+void Paintbrush::useToolAtPoint(const std::shared_ptr<Frame> &frame, const Paint &paintSettings, int x, int y)
+{
+    //A point is a line with no length
+    useToolOnLine(frame, paintSettings, x, y, x, y);
+}
+
+///
+/// \brief Paintbrush::useToolOnPolyline Uses paintbrush along the lines connecting the given points, in one pass.
+///        This colors the pixels within the tool to the colors specified in paintSettings, dithering if option is on.
+/// \param frame to use paintbrush on
+/// \param paintSettings Settings for the tool, including color, dithering, and tool size.
+/// \param points the points to connect, in order
+///
+void Paintbrush::useToolOnPolyline(const std::shared_ptr<Frame> &frame, const Paint &paintSettings, const QPolygon &points)
+{
+    Stencil stencil = polylineStencil(frame->canvas, paintSettings.getToolSize(), points);
+    QRect bounds = stencil.getBounds();
+    if (bounds.isEmpty())
+    {
+        return;
+    }
+    //The pattern is fixed for the whole segment, so pick the kernel once
+    ToolKernels::applyStencil(frame->canvas, stencil, BlendMode::Replace, *paintSettings.getPattern());
+
+    frame->markDirty(bounds);
+    frame->afterCanvasChanged();
+}
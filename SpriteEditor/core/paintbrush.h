@@ -12,8 +12,8 @@
 class Paintbrush : public Tool
 {
 public:
-    void useToolAtPoint(std::shared_ptr<Frame> frame, Paint color, int x, int y);
-    void useToolOnLine(std::shared_ptr<Frame> frame, Paint color, int x1, int y1, int x2, int y2);
+    void useToolAtPoint(const std::shared_ptr<Frame> &frame, const Paint &color, int x, int y);
+    void useToolOnPolyline(const std::shared_ptr<Frame> &frame, const Paint &color, const QPolygon &points);
 };
 
 #endif // PAINTBRUSH_H
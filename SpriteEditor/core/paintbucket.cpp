@@ -0,0 +1,187 @@
+//Code style reviewed by Cameron Wortmann 4/5/2023
+#include "paintbucket.h"
+#include <cstring>
+
+///
+/// \brief PaintBucket::useToolAtSinglePoint Uses paint bucket at the point with coordinates (x,y)
+///        This flood fills frame from every pixel of the tool, as one fill, with the current color settings.
+/// \param frame to use paint bucket on
+/// \param paintSettings Settings for the tool, including color, dithering, and tool size.
+/// \param x coordinate from which flood fill starts from
+/// \param y coordinate from which flood fill starts from
+///
+void PaintBucket::useToolAtPoint(const std::shared_ptr<Frame> &frame, const Paint &paintSettings, int x, int y)
+{
+    int size = paintSettings.getToolSize();
+    std::vector<QPoint> seeds;
+    //For every width of the tool
+    for (int i = 0; i < size && (x+i) < frame->canvas.width(); i++)
+    {
+        //For every height of the tool
+        for (int j = 0; j < size && (y+j) < frame->canvas.height(); j++)
+        {
+            seeds.push_back(QPoint(x + i, y + j));
+        }
+    }
+
+    QRect filled = fillFromSeeds(frame, paintSettings, seeds);
+    if (filled.isNull())
+    {
+        return;
+    }
+    frame->markDirty(filled);
+    frame->afterCanvasChanged();
+}
+
+///
+/// \brief PaintBucket::useToolOnPolyline Uses paintbucket along the lines connecting the given points.
+///        Every pixel covered by the lines (and the tool around them) seeds one shared flood fill, so the
+///        whole polyline produces a single canvas change.
+/// \param frame to use paintbucket on
+/// \param paintSettings Settings for the tool, including color, dithering, and tool size.
+/// \param points the points to connect, in order
+///
+void PaintBucket::useToolOnPolyline(const std::shared_ptr<Frame> &frame, const Paint &paintSettings, const QPolygon &points)
+{
+    int size = paintSettings.getToolSize();
+    //The tool footprint around every point of a line of width size is a line of width 2*size-1
+    Stencil stencil = polylineStencil(frame->canvas, 2 * size - 1, points);
+    QRect bounds = stencil.getBounds();
+    std::vector<QPoint> seeds;
+    //For every row of the stencil's bounding box
+    for (int currentY = bounds.top(); currentY <= bounds.bottom(); currentY++)
+    {
+        const uchar *covered = stencil.row(currentY);
+        //For every pixel of the row
+        for (int currentX = bounds.left(); currentX <= bounds.right(); currentX++)
+        {
+            //If stencil filled in for this pixel, start filling from this point too.
+            if (covered[currentX - bounds.left()])
+            {
+                seeds.push_back(QPoint(currentX, currentY));
+            }
+        }
+    }
+
+    QRect filled = fillFromSeeds(frame, paintSettings, seeds);
+    if (filled.isNull())
+    {
+        return;
+    }
+    frame->markDirty(filled);
+    frame->afterCanvasChanged();
+}
+
+///
+/// \brief PaintBucket::fillFromSeeds Private scanline flood fill. Each seed fills the region of pixels connected to it
+///        that share its color; a visited bitmap shared by all seeds keeps any pixel from being filled twice.
+/// \param frame to use paint bucket on
+/// \param paintSettings Paint to get the fill colors from
+/// \param seeds points from which flood fill starts from
+/// \return bounding rectangle of the filled pixels
+///
+QRect PaintBucket::fillFromSeeds(const std::shared_ptr<Frame> &frame, const Paint &paintSettings, const std::vector<QPoint> &seeds)
+{
+    QImage &canvas = frame->canvas;
+    if (canvas.format() != QImage::Format_ARGB32)
+    {
+        canvas = canvas.convertToFormat(QImage::Format_ARGB32);
+    }
+
+    int width = canvas.width();
+    int height = canvas.height();
+    std::vector<QRgb*> rows(height);
+    for (int y = 0; y < height; y++)
+    {
+        rows[y] = reinterpret_cast<QRgb*>(canvas.scanLine(y));
+    }
+    std::vector<uchar> visited(width * height, 0);
+
+    QRgb primary = paintSettings.getPrimaryColor().rgba();
+    bool dithering = paintSettings.getDithering();
+    std::shared_ptr<const DitherPattern> pattern = paintSettings.getPattern();
+
+    int minX = width, minY = height, maxX = -1, maxY = -1;
+    std::vector<QPoint> pending;
+    for (const QPoint &seed : seeds)
+    {
+        if (!canvas.valid(seed) || visited[seed.y() * width + seed.x()])
+        {
+            continue;
+        }
+
+        QRgb target = rows[seed.y()][seed.x()];
+        //Filling a region with its own color changes nothing
+        if (!dithering && target == primary)
+        {
+            continue;
+        }
+
+        pending.push_back(seed);
+        while (!pending.empty())
+        {
+            QPoint current = pending.back();
+            pending.pop_back();
+            int y = current.y();
+            QRgb *line = rows[y];
+            uchar *seen = &visited[y * width];
+            if (seen[current.x()] || line[current.x()] != target)
+            {
+                continue;
+            }
+
+            //Extend the span left and right as far as the region goes
+            int left = current.x();
+            while (left > 0 && !seen[left - 1] && line[left - 1] == target)
+            {
+                left--;
+            }
+            int right = current.x();
+            while (right < width - 1 && !seen[right + 1] && line[right + 1] == target)
+            {
+                right++;
+            }
+
+            //Paint the span
+            std::memset(seen + left, 1, right - left + 1);
+            pattern->fillRow(line + left, left, y, right - left + 1);
+            minX = std::min(minX, left);
+            maxX = std::max(maxX, right);
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+
+            //Queue one point for every run of the region in the rows above and below the span
+            for (int adjacentY = y - 1; adjacentY <= y + 1; adjacentY += 2)
+            {
+                if (adjacentY < 0 || adjacentY >= height)
+                {
+                    continue;
+                }
+                QRgb *adjacent = rows[adjacentY];
+                uchar *adjacentSeen = &visited[adjacentY * width];
+                bool inRun = false;
+                for (int x = left; x <= right; x++)
+                {
+                    if (!adjacentSeen[x] && adjacent[x] == target)
+                    {
+                        if (!inRun)
+                        {
+                            pending.push_back(QPoint(x, adjacentY));
+                        }
+                        inRun = true;
+                    }
+                    else
+                    {
+                        inRun = false;
+                    }
+                }
+            }
+        }
+    }
+
+    if (maxX < 0)
+    {
+        return QRect();
+    }
+    return QRect(QPoint(minX, minY), QPoint(maxX, maxY));
+}
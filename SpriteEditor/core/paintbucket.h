@@ -2,7 +2,7 @@
 #define PAINTBUCKET_H
 
 #include "tool.h"
-#include <queue>
+#include <vector>
 
 ///
 /// \brief The Paintbucket class a tool that can be used on the canvas to fill areas of pixels (set color).
@@ -12,11 +12,11 @@
 ///
 class PaintBucket : public Tool
 {
-    bool validPaintablePoint(std::shared_ptr<Frame> frame, Paint newColor, QColor oldColor, int x, int y);
+    QRect fillFromSeeds(const std::shared_ptr<Frame> &frame, const Paint &paintSettings, const std::vector<QPoint> &seeds);
 
 public:
-    void useToolAtPoint(std::shared_ptr<Frame> frame, Paint color, int x, int y);
-    void useToolOnLine(std::shared_ptr<Frame> frame, Paint color, int x1, int y1, int x2, int y2);
+    void useToolAtPoint(const std::shared_ptr<Frame> &frame, const Paint &color, int x, int y);
+    void useToolOnPolyline(const std::shared_ptr<Frame> &frame, const Paint &color, const QPolygon &points);
 };
 
 #endif // PAINTBUCKET_H
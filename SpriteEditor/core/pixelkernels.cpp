@@ -0,0 +1,342 @@
+#include "pixelkernels.h"
+#include <atomic>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PIXELKERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(PIXELKERNELS_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define PIXELKERNELS_AVX2
+#include <immintrin.h>
+#endif
+
+// One implementation of every kernel.
+struct KernelTable
+{
+    const char *name;
+    void (*fillRowMasked)(QRgb *dst, const uchar *mask, int count, QRgb color);
+    bool (*rowsEqual)(const QRgb *a, const QRgb *b, int count);
+    void (*copyRowMasked)(QRgb *dst, const QRgb *src, const uchar *mask, int count);
+};
+
+//
+// Scalar kernels, used on every platform and for the tail of each row in the vector kernels.
+//
+
+static void scalarFillRowMasked(QRgb *dst, const uchar *mask, int count, QRgb color)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (mask[i])
+        {
+            dst[i] = color;
+        }
+    }
+}
+
+static bool scalarRowsEqual(const QRgb *a, const QRgb *b, int count)
+{
+    return std::memcmp(a, b, count * sizeof(QRgb)) == 0;
+}
+
+static void scalarCopyRowMasked(QRgb *dst, const QRgb *src, const uchar *mask, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (mask[i])
+        {
+            dst[i] = src[i];
+        }
+    }
+}
+
+static const KernelTable scalarKernels = {
+    "scalar", scalarFillRowMasked, scalarRowsEqual, scalarCopyRowMasked
+};
+
+#ifdef PIXELKERNELS_SSE2
+//
+// SSE2 kernels, 4 pixels at a time.
+//
+
+static void sse2FillRowMasked(QRgb *dst, const uchar *mask, int count, QRgb color)
+{
+    __m128i pattern = _mm_set1_epi32(color);
+    __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        int maskBytes;
+        std::memcpy(&maskBytes, mask + i, sizeof(maskBytes));
+        if (maskBytes == 0)
+        {
+            continue;
+        }
+        // widen the 4 mask bytes to 4 lanes of all-ones / all-zeros
+        __m128i lanes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(maskBytes), zero), zero);
+        __m128i select = _mm_xor_si128(_mm_cmpeq_epi32(lanes, zero), _mm_set1_epi32(-1));
+        __m128i *target = reinterpret_cast<__m128i*>(dst + i);
+        __m128i current = _mm_loadu_si128(target);
+        _mm_storeu_si128(target, _mm_or_si128(_mm_and_si128(select, pattern), _mm_andnot_si128(select, current)));
+    }
+    scalarFillRowMasked(dst + i, mask + i, count - i, color);
+}
+
+static bool sse2RowsEqual(const QRgb *a, const QRgb *b, int count)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(left, right)) != 0xFFFF)
+        {
+            return false;
+        }
+    }
+    return scalarRowsEqual(a + i, b + i, count - i);
+}
+
+static void sse2CopyRowMasked(QRgb *dst, const QRgb *src, const uchar *mask, int count)
+{
+    __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        int maskBytes;
+        std::memcpy(&maskBytes, mask + i, sizeof(maskBytes));
+        if (maskBytes == 0)
+        {
+            continue;
+        }
+        __m128i lanes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(maskBytes), zero), zero);
+        __m128i select = _mm_xor_si128(_mm_cmpeq_epi32(lanes, zero), _mm_set1_epi32(-1));
+        __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i *target = reinterpret_cast<__m128i*>(dst + i);
+        __m128i current = _mm_loadu_si128(target);
+        _mm_storeu_si128(target, _mm_or_si128(_mm_and_si128(select, source), _mm_andnot_si128(select, current)));
+    }
+    scalarCopyRowMasked(dst + i, src + i, mask + i, count - i);
+}
+
+static const KernelTable sse2Kernels = {
+    "sse2", sse2FillRowMasked, sse2RowsEqual, sse2CopyRowMasked
+};
+#endif
+
+#ifdef PIXELKERNELS_AVX2
+//
+// AVX2 kernels, 8 pixels at a time. Compiled for AVX2 but only called when the CPU reports it.
+//
+
+__attribute__((target("avx2")))
+static void avx2FillRowMasked(QRgb *dst, const uchar *mask, int count, QRgb color)
+{
+    __m256i pattern = _mm256_set1_epi32(color);
+    __m256i zero = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        // widen the 8 mask bytes to 8 lanes of all-ones / all-zeros
+        __m256i lanes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(mask + i)));
+        __m256i select = _mm256_xor_si256(_mm256_cmpeq_epi32(lanes, zero), _mm256_set1_epi32(-1));
+        __m256i *target = reinterpret_cast<__m256i*>(dst + i);
+        _mm256_storeu_si256(target, _mm256_blendv_epi8(_mm256_loadu_si256(target), pattern, select));
+    }
+    scalarFillRowMasked(dst + i, mask + i, count - i, color);
+}
+
+__attribute__((target("avx2")))
+static bool avx2RowsEqual(const QRgb *a, const QRgb *b, int count)
+{
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(left, right)) != -1)
+        {
+            return false;
+        }
+    }
+    return scalarRowsEqual(a + i, b + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void avx2CopyRowMasked(QRgb *dst, const QRgb *src, const uchar *mask, int count)
+{
+    __m256i zero = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i lanes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(mask + i)));
+        __m256i select = _mm256_xor_si256(_mm256_cmpeq_epi32(lanes, zero), _mm256_set1_epi32(-1));
+        __m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i *target = reinterpret_cast<__m256i*>(dst + i);
+        _mm256_storeu_si256(target, _mm256_blendv_epi8(_mm256_loadu_si256(target), source, select));
+    }
+    scalarCopyRowMasked(dst + i, src + i, mask + i, count - i);
+}
+
+static const KernelTable avx2Kernels = {
+    "avx2", avx2FillRowMasked, avx2RowsEqual, avx2CopyRowMasked
+};
+#endif
+
+///
+/// \brief supportedKernels
+/// \return every kernel table this build and CPU can run, fastest first
+///
+static std::vector<const KernelTable *> supportedKernels()
+{
+    std::vector<const KernelTable *> supported;
+#ifdef PIXELKERNELS_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        supported.push_back(&avx2Kernels);
+    }
+#endif
+#ifdef PIXELKERNELS_SSE2
+    supported.push_back(&sse2Kernels);
+#endif
+    supported.push_back(&scalarKernels);
+    return supported;
+}
+
+// the kernels in use, or null until the first kernel is called
+static std::atomic<const KernelTable *> activeKernels { nullptr };
+
+///
+/// \brief kernels pick the fastest kernels for this CPU, the first time they are needed
+/// \return the kernel table to use
+///
+static const KernelTable &kernels()
+{
+    const KernelTable *active = activeKernels.load(std::memory_order_acquire);
+    if (!active)
+    {
+        // every thread that gets here picks the same table, so it doesn't matter which one stores it
+        active = supportedKernels().front();
+        activeKernels.store(active, std::memory_order_release);
+    }
+    return *active;
+}
+
+///
+/// \brief PixelKernels::fillRowMasked set the pixels whose mask byte is nonzero to color
+/// \param dst first pixel to write
+/// \param mask one byte per pixel
+/// \param count number of pixels
+/// \param color ARGB value to write
+///
+void PixelKernels::fillRowMasked(QRgb *dst, const uchar *mask, int count, QRgb color)
+{
+    kernels().fillRowMasked(dst, mask, count, color);
+}
+
+///
+/// \brief PixelKernels::eraseRowMasked make the pixels whose mask byte is nonzero fully transparent
+/// \param dst first pixel to write
+/// \param mask one byte per pixel
+/// \param count number of pixels
+///
+void PixelKernels::eraseRowMasked(QRgb *dst, const uchar *mask, int count)
+{
+    kernels().fillRowMasked(dst, mask, count, 0);
+}
+
+///
+/// \brief PixelKernels::rowsEqual compare two rows of pixels
+/// \param a first row
+/// \param b second row
+/// \param count number of pixels
+/// \return true iff every pixel is the same
+///
+bool PixelKernels::rowsEqual(const QRgb *a, const QRgb *b, int count)
+{
+    return kernels().rowsEqual(a, b, count);
+}
+
+///
+/// \brief PixelKernels::copyRow copy count pixels. memcpy is already vectorized by every C library we build
+///        against, so there is no hand-written version.
+/// \param dst first pixel to write
+/// \param src first pixel to read
+/// \param count number of pixels
+///
+void PixelKernels::copyRow(QRgb *dst, const QRgb *src, int count)
+{
+    std::memcpy(dst, src, count * sizeof(QRgb));
+}
+
+///
+/// \brief PixelKernels::copyRowMasked copy the pixels whose mask byte is nonzero
+/// \param dst first pixel to write
+/// \param src first pixel to read
+/// \param mask one byte per pixel
+/// \param count number of pixels
+///
+void PixelKernels::copyRowMasked(QRgb *dst, const QRgb *src, const uchar *mask, int count)
+{
+    kernels().copyRowMasked(dst, src, mask, count);
+}
+
+///
+/// \brief PixelKernels::xorRow XOR count pixels of src into dst. Compilers vectorize this loop on their own, so
+///        there is no hand-written version.
+/// \param dst first pixel to read and write
+/// \param src first pixel to read
+/// \param count number of pixels
+///
+void PixelKernels::xorRow(QRgb *dst, const QRgb *src, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        dst[i] ^= src[i];
+    }
+}
+
+///
+/// \brief PixelKernels::instructionSet
+/// \return name of the kernels in use ("avx2", "sse2" or "scalar")
+///
+const char *PixelKernels::instructionSet()
+{
+    return kernels().name;
+}
+
+///
+/// \brief PixelKernels::supportedInstructionSets
+/// \return names of the kernels this CPU can run, fastest first; "scalar" is always last
+///
+std::vector<const char *> PixelKernels::supportedInstructionSets()
+{
+    std::vector<const char *> names;
+    for (const KernelTable *table : supportedKernels())
+    {
+        names.push_back(table->name);
+    }
+    return names;
+}
+
+///
+/// \brief PixelKernels::useInstructionSet use the given kernels from now on instead of the fastest ones, so tests
+///        and benchmarks can compare them. Don't call it while another thread is using the kernels.
+/// \param name one of supportedInstructionSets()
+/// \return false (and nothing changes) if this CPU can't run those kernels
+///
+bool PixelKernels::useInstructionSet(const char *name)
+{
+    for (const KernelTable *table : supportedKernels())
+    {
+        if (std::strcmp(table->name, name) == 0)
+        {
+            activeKernels.store(table, std::memory_order_release);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,27 @@
+#ifndef PIXELKERNELS_H
+#define PIXELKERNELS_H
+
+#include <QRgb>
+#include <vector>
+
+///
+/// \brief The PixelKernels class holds the row operations the tools and Frame use on ARGB32 scanlines.
+///        Each has a scalar version plus SSE2 and AVX2 versions; the fastest one the CPU supports is picked
+///        the first time a kernel is used, unless useInstructionSet picked one already.
+///
+class PixelKernels
+{
+public:
+    static void fillRowMasked(QRgb *dst, const uchar *mask, int count, QRgb color);
+    static void eraseRowMasked(QRgb *dst, const uchar *mask, int count);
+    static bool rowsEqual(const QRgb *a, const QRgb *b, int count);
+    static void copyRow(QRgb *dst, const QRgb *src, int count);
+    static void copyRowMasked(QRgb *dst, const QRgb *src, const uchar *mask, int count);
+    static void xorRow(QRgb *dst, const QRgb *src, int count);
+
+    static const char *instructionSet();
+    static std::vector<const char *> supportedInstructionSets();
+    static bool useInstructionSet(const char *name);
+};
+
+#endif // PIXELKERNELS_H
@@ -0,0 +1,744 @@
+#include "spritefile.h"
+#include "fileerror.h"
+#include "pixelkernels.h"
+#include <QDataStream>
+#include <QRandomGenerator>
+#include <QtConcurrent>
+#include <QtEndian>
+#include <algorithm>
+#include <unordered_set>
+
+static const char MAGIC[4] = { 'S', 'S', 'P', 'B' };
+
+// zlib level for frame blocks; pixel art compresses well even at the fastest level
+static const int COMPRESSION_LEVEL = 1;
+
+///
+/// \brief SpriteFile::isSpriteFile check whether a device holds the binary format, without consuming anything
+/// \param device open, readable device positioned at the start of the file
+/// \return true if the device starts with the binary format's magic bytes
+///
+bool SpriteFile::isSpriteFile(QIODevice *device)
+{
+    return device->peek(sizeof(MAGIC)) == QByteArray(MAGIC, sizeof(MAGIC));
+}
+
+///
+/// \brief SpriteFile::write write a snapshot in the binary format
+/// \param device open, writable device
+/// \param snapshot the animation to write; every frame must have its pixels. A frame of another size than
+///        snapshot.frameSize (one whose resize was undone, say) is cropped or padded to it, since every block is
+///        read back at the header's frame size.
+/// \param error set to a message for the user if writing fails
+/// \param layout if given, set to what was written, for append()
+/// \param keyframeInterval most frames in a chain of deltas, counting the whole frame it starts from; 1 stores
+///        every frame whole, which version 2 readers can open
+/// \return true if written successfully
+///
+bool SpriteFile::write(QIODevice *device, const AnimationSnapshot &snapshot, QString *error, Layout *layout, int keyframeInterval)
+{
+    Layout written;
+    written.fileSize = HEADER_SIZE;
+    std::vector<FrameEntry> entries;
+    QList<EncodedFrame> encoded = encodeBlocks(snapshot, written, entries, keyframeInterval);
+
+    Header header;
+    header.version = versionFor(encoded);
+    header.frameSize = snapshot.frameSize;
+    header.frameCount = snapshot.frames.size();
+    header.indexOffset = written.fileSize;
+    header.generation = QRandomGenerator::global()->generate();
+
+    bool ok = device->write(headerBytes(header)) == HEADER_SIZE;
+    for (const EncodedFrame &frame : encoded)
+    {
+        ok = ok && device->write(frame.block) == frame.block.size();
+    }
+    QByteArray table = tableBytes(entries);
+    ok = ok && device->write(table) == table.size();
+    if (!ok)
+    {
+        setError(error, device->errorString());
+        return false;
+    }
+
+    if (layout)
+    {
+        written.fileSize += table.size();
+        written.liveBytes = written.fileSize;
+        written.indexOffset = header.indexOffset;
+        written.generation = header.generation;
+        *layout = std::move(written);
+    }
+    return true;
+}
+
+///
+/// \brief SpriteFile::append save a snapshot into a file written by write() or append(), adding only the blocks of
+///        frames whose revision the file doesn't hold yet. The header is rewritten last, so if anything fails before
+///        that the file still holds what it did before.
+/// \param device open, readable and writable device holding the file
+/// \param snapshot the animation to write; frames whose revision is in layout may leave out their pixels
+/// \param layout what the file holds; updated to what it holds afterwards
+/// \param error set to a message for the user if writing fails
+/// \param keyframeInterval see write()
+/// \return true if written successfully; if false, write the whole file with write() instead
+///
+bool SpriteFile::append(QIODevice *device, const AnimationSnapshot &snapshot, Layout &layout, QString *error, int keyframeInterval)
+{
+    Header header;
+    if (!device->seek(0) || !parseHeader(device->read(HEADER_SIZE), header, error))
+    {
+        return false;
+    }
+    // a file rewritten by something else is often the same size, but it won't have the same table and generation
+    if ((quint64)device->size() != layout.fileSize || header.indexOffset != layout.indexOffset
+        || header.generation != layout.generation)
+    {
+        setError(error, "The file was changed since it was last saved.");
+        return false;
+    }
+    if (header.frameSize != snapshot.frameSize)
+    {
+        // the blocks already in the file are the old size, and every frame has to be the header's size
+        setError(error, "The frames were resized since the file was last saved.");
+        return false;
+    }
+
+    Layout updated = layout;
+    std::vector<FrameEntry> entries;
+    QList<EncodedFrame> encoded = encodeBlocks(snapshot, updated, entries, keyframeInterval);
+
+    bool ok = device->seek(layout.fileSize);
+    for (const EncodedFrame &frame : encoded)
+    {
+        ok = ok && device->write(frame.block) == frame.block.size();
+    }
+    QByteArray table = tableBytes(entries);
+    ok = ok && device->write(table) == table.size();
+
+    header.version = std::max(header.version, versionFor(encoded));
+    header.frameSize = snapshot.frameSize;
+    header.frameCount = snapshot.frames.size();
+    header.indexOffset = updated.fileSize;
+    header.generation++;
+    ok = ok && device->seek(0) && device->write(headerBytes(header)) == HEADER_SIZE;
+    if (!ok)
+    {
+        setError(error, device->errorString());
+        return false;
+    }
+
+    // blocks no frame uses any more are forgotten; they stay in the file as waste until it is compacted
+    layout = layoutOf(header, updated.fileSize + table.size(), entries, snapshot.revisions);
+    return true;
+}
+
+///
+/// \brief SpriteFile::shouldCompact
+/// \param layout what a file holds
+/// \return true if most of the file is blocks no frame uses any more, so it should be written anew with write()
+///
+bool SpriteFile::shouldCompact(const Layout &layout)
+{
+    return layout.fileSize > 2 * layout.liveBytes;
+}
+
+///
+/// \brief SpriteFile::layoutOf describe what a file holds, for append()
+/// \param header the file's header
+/// \param fileSize size of the whole file
+/// \param entries the file's frame table
+/// \param revisions revision of the frame each entry was loaded into
+/// \return the layout
+///
+SpriteFile::Layout SpriteFile::layoutOf(const Header &header, quint64 fileSize, const std::vector<FrameEntry> &entries,
+                                        const std::vector<quint64> &revisions)
+{
+    Layout layout;
+    layout.fileSize = fileSize;
+    layout.indexOffset = header.indexOffset;
+    layout.generation = header.generation;
+    layout.liveBytes = HEADER_SIZE + (quint64)entries.size() * ENTRY_SIZE;
+    std::unordered_map<quint64, quint32> usedBlocks;
+    for (size_t i = 0; i < entries.size() && i < revisions.size(); i++)
+    {
+        layout.blocks[revisions[i]] = entries[i];
+        usedBlocks[entries[i].offset] = entries[i].length;
+    }
+    for (const auto &block : usedBlocks)
+    {
+        layout.liveBytes += block.second;
+    }
+    return layout;
+}
+
+///
+/// \brief SpriteFile::encodeBlocks encode the frames whose blocks aren't in a file yet, on the thread pool. A frame
+///        whose previous frame is encoded too is stored as a delta from it, unless that would make the chain of
+///        deltas back to a whole frame longer than keyframeInterval or most of the frame changed.
+/// \param snapshot the animation being written
+/// \param layout what the file holds; the new blocks are placed from layout.fileSize on, and added to it
+/// \param entries set to the frame table: the block of every frame, old or new
+/// \param keyframeInterval most frames in a chain of deltas, counting the whole frame it starts from
+/// \return the new blocks, in the order they go in the file
+///
+QList<SpriteFile::EncodedFrame> SpriteFile::encodeBlocks(const AnimationSnapshot &snapshot, Layout &layout, std::vector<FrameEntry> &entries,
+                                                         int keyframeInterval)
+{
+    struct Job
+    {
+        QImage canvas;
+        // null for a frame stored whole
+        QImage base;
+    };
+
+    size_t frameCount = snapshot.frames.size();
+    bool hasRevisions = snapshot.revisions.size() == frameCount;
+
+    //Frames that share a revision (copies) share a block, so each new revision is encoded once
+    QList<Job> jobs;
+    std::vector<size_t> jobFrame;
+    std::unordered_map<quint64, size_t> pending;
+    // frames in the chain up to and including each frame's block, if it is being encoded now
+    std::vector<int> chainLength(frameCount, 0);
+    for (size_t i = 0; i < frameCount; i++)
+    {
+        if (hasRevisions && layout.blocks.count(snapshot.revisions[i]))
+        {
+            continue;
+        }
+        if (hasRevisions && pending.count(snapshot.revisions[i]))
+        {
+            chainLength[i] = chainLength[pending[snapshot.revisions[i]]];
+            continue;
+        }
+        if (hasRevisions)
+        {
+            pending[snapshot.revisions[i]] = i;
+        }
+
+        Job job { snapshot.frames[i], QImage() };
+        chainLength[i] = 1;
+        if (i > 0 && chainLength[i - 1] > 0 && chainLength[i - 1] < keyframeInterval)
+        {
+            job.base = snapshot.frames[i - 1];
+            chainLength[i] = chainLength[i - 1] + 1;
+        }
+        jobs.append(job);
+        jobFrame.push_back(i);
+    }
+
+    //Frames are independent, so encode them on the thread pool; blockingMapped keeps them in order
+    QSize frameSize = snapshot.frameSize;
+    auto encode = [frameSize](const Job &job)
+    {
+        //Readers decode every block at the header's frame size, so never write one of another size
+        QImage canvas = fitToSize(job.canvas, frameSize);
+        EncodedFrame frame;
+        if (!job.base.isNull())
+        {
+            frame.block = encodeDelta(canvas, fitToSize(job.base, frameSize));
+            frame.encoding = Encoding::Delta;
+        }
+        if (frame.block.isEmpty())
+        {
+            frame.block = encodeFrame(canvas, frame.encoding);
+        }
+        return frame;
+    };
+    QList<EncodedFrame> encoded = QtConcurrent::blockingMapped<QList<EncodedFrame>>(jobs, encode);
+
+    entries.assign(frameCount, FrameEntry());
+    for (int k = 0; k < encoded.size(); k++)
+    {
+        size_t i = jobFrame[k];
+        if (encoded[k].encoding == Encoding::Delta)
+        {
+            // the base is the previous frame's block, which is placed by now (or was already in the file)
+            FrameEntry base = hasRevisions ? layout.blocks[snapshot.revisions[i - 1]] : entries[i - 1];
+            encoded[k].block.replace(0, ENTRY_SIZE, tableBytes({ base }));
+        }
+
+        FrameEntry &entry = entries[i];
+        entry.encoding = encoded[k].encoding;
+        entry.offset = layout.fileSize;
+        entry.length = encoded[k].block.size();
+        layout.fileSize += encoded[k].block.size();
+        if (hasRevisions)
+        {
+            layout.blocks[snapshot.revisions[i]] = entry;
+        }
+    }
+    if (hasRevisions)
+    {
+        for (size_t i = 0; i < frameCount; i++)
+        {
+            entries[i] = layout.blocks[snapshot.revisions[i]];
+        }
+    }
+    return encoded;
+}
+
+///
+/// \brief SpriteFile::encodeDelta store a frame as its change from a base frame
+/// \param canvas the frame's canvas
+/// \param base the base frame's canvas
+/// \return the block, with room for the base's table entry left at the start; empty if the frame should be
+///         stored whole instead
+///
+QByteArray SpriteFile::encodeDelta(const QImage &canvas, const QImage &base)
+{
+    QImage image = canvas.format() == QImage::Format_ARGB32 ? canvas : canvas.convertToFormat(QImage::Format_ARGB32);
+    QImage previous = base.format() == QImage::Format_ARGB32 ? base : base.convertToFormat(QImage::Format_ARGB32);
+    if (image.size() != previous.size())
+    {
+        return QByteArray();
+    }
+
+    //Find the smallest rectangle holding every changed pixel
+    int width = image.width();
+    int top = 0;
+    int bottom = image.height() - 1;
+    auto row = [](const QImage &from, int y) { return reinterpret_cast<const QRgb*>(from.constScanLine(y)); };
+    while (top <= bottom && PixelKernels::rowsEqual(row(image, top), row(previous, top), width))
+    {
+        top++;
+    }
+    while (bottom > top && PixelKernels::rowsEqual(row(image, bottom), row(previous, bottom), width))
+    {
+        bottom--;
+    }
+    int left = width;
+    int right = -1;
+    for (int y = top; y <= bottom; y++)
+    {
+        const QRgb *now = row(image, y);
+        const QRgb *before = row(previous, y);
+        int x = 0;
+        while (x < left && now[x] == before[x])
+        {
+            x++;
+        }
+        left = x;
+        x = width - 1;
+        while (x > right && now[x] == before[x])
+        {
+            x--;
+        }
+        right = x;
+    }
+    QRect changed = right < left ? QRect() : QRect(left, top, right - left + 1, bottom - top + 1);
+
+    // a change covering most of the frame compresses no better than the whole frame
+    if ((qint64)changed.width() * changed.height() * 2 > (qint64)width * image.height())
+    {
+        return QByteArray();
+    }
+
+    QByteArray block;
+    QDataStream out(&block, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.writeRawData(QByteArray(ENTRY_SIZE, 0).constData(), ENTRY_SIZE);
+    out << (quint32)changed.x() << (quint32)changed.y() << (quint32)changed.width() << (quint32)changed.height();
+    if (changed.isEmpty())
+    {
+        return block;
+    }
+
+    int rowBytes = changed.width() * (int)sizeof(QRgb);
+    QByteArray raw(rowBytes * changed.height(), Qt::Uninitialized);
+    std::vector<QRgb> difference(changed.width());
+    for (int y = 0; y < changed.height(); y++)
+    {
+        PixelKernels::copyRow(difference.data(), row(image, changed.y() + y) + changed.x(), changed.width());
+        PixelKernels::xorRow(difference.data(), row(previous, changed.y() + y) + changed.x(), changed.width());
+        qToLittleEndian<quint32>(difference.data(), changed.width(), raw.data() + y * rowBytes);
+    }
+    block.append(qCompress(raw, COMPRESSION_LEVEL));
+    return block;
+}
+
+///
+/// \brief SpriteFile::versionFor
+/// \param blocks blocks being written
+/// \return the oldest format version that can read them
+///
+quint16 SpriteFile::versionFor(const QList<EncodedFrame> &blocks)
+{
+    for (const EncodedFrame &frame : blocks)
+    {
+        if (frame.encoding == Encoding::Delta)
+        {
+            return 3;
+        }
+    }
+    return 2;
+}
+
+///
+/// \brief SpriteFile::read read a snapshot in the binary format
+/// \param device open, readable device positioned at the start of the file
+/// \param snapshot filled with the animation
+/// \param error set to a message for the user if reading fails
+/// \return true if read successfully
+///
+bool SpriteFile::read(QIODevice *device, AnimationSnapshot &snapshot, QString *error)
+{
+    Header header;
+    if (!parseHeader(device->read(HEADER_SIZE), header, error))
+    {
+        return false;
+    }
+
+    if (!device->seek(header.indexOffset))
+    {
+        setError(error, "The frame table is missing or damaged.");
+        return false;
+    }
+    std::vector<FrameEntry> entries;
+    if (!parseTable(device->read((qint64)header.frameCount * ENTRY_SIZE), header.frameCount, device->size(), entries, error))
+    {
+        return false;
+    }
+
+    //Read and decompress the blocks on the thread pool: first the ones the table refers to, then the bases of the
+    //deltas among them, which may be blocks the table no longer refers to
+    QSize frameSize = header.frameSize;
+    auto decode = [frameSize](const EncodedFrame &frame)
+    {
+        return decodeBlock(frame.block, frame.encoding, frameSize);
+    };
+    std::unordered_map<quint64, DecodedBlock> decoded;
+    std::vector<FrameEntry> toRead = entries;
+    while (!toRead.empty())
+    {
+        QList<EncodedFrame> encoded;
+        std::vector<quint64> offsets;
+        std::unordered_set<quint64> queued;
+        for (const FrameEntry &entry : toRead)
+        {
+            if (decoded.count(entry.offset) || !queued.insert(entry.offset).second)
+            {
+                continue;
+            }
+            EncodedFrame frame;
+            frame.encoding = entry.encoding;
+            if (entry.offset + entry.length <= (quint64)device->size() && device->seek(entry.offset))
+            {
+                frame.block = device->read(entry.length);
+            }
+            encoded.append(std::move(frame));
+            offsets.push_back(entry.offset);
+        }
+
+        QList<DecodedBlock> blocks = QtConcurrent::blockingMapped<QList<DecodedBlock>>(encoded, decode);
+        toRead.clear();
+        for (int k = 0; k < blocks.size(); k++)
+        {
+            // a base is always earlier in the file, so following bases always ends
+            if (!blocks[k].valid || (blocks[k].delta && blocks[k].base.offset >= offsets[k]))
+            {
+                setError(error, "A frame is damaged.");
+                return false;
+            }
+            if (blocks[k].delta)
+            {
+                toRead.push_back(blocks[k].base);
+            }
+            decoded[offsets[k]] = std::move(blocks[k]);
+        }
+    }
+
+    //Applying a delta is a cheap XOR of its rectangle, so rebuild the frames in order on this thread
+    std::unordered_map<quint64, QImage> frames;
+    auto resolve = [&decoded, &frames](quint64 offset)
+    {
+        std::vector<quint64> chain;
+        while (!frames.count(offset) && decoded[offset].delta)
+        {
+            chain.push_back(offset);
+            offset = decoded[offset].base.offset;
+        }
+        QImage image = frames.count(offset) ? frames[offset] : decoded[offset].image;
+        frames[offset] = image;
+        for (auto link = chain.crbegin(); link != chain.crend(); link++)
+        {
+            image = applyDelta(image, decoded[*link]);
+            frames[*link] = image;
+        }
+        return image;
+    };
+
+    AnimationSnapshot loaded;
+    loaded.frameSize = frameSize;
+    for (const FrameEntry &entry : entries)
+    {
+        loaded.frames.push_back(resolve(entry.offset));
+    }
+
+    snapshot = std::move(loaded);
+    return true;
+}
+
+///
+/// \brief SpriteFile::fitToSize crop or pad a frame to the animation's size. Safe to call from any thread.
+/// \param canvas the frame
+/// \param size the animation's frame size
+/// \return the frame at that size; pixels it didn't have are transparent
+///
+QImage SpriteFile::fitToSize(const QImage &canvas, const QSize &size)
+{
+    if (canvas.size() == size)
+    {
+        return canvas;
+    }
+
+    QImage image = canvas.format() == QImage::Format_ARGB32 ? canvas : canvas.convertToFormat(QImage::Format_ARGB32);
+    QImage fitted(size, QImage::Format_ARGB32);
+    fitted.fill(Qt::transparent);
+    int width = std::min(image.width(), size.width());
+    for (int y = 0; y < std::min(image.height(), size.height()); y++)
+    {
+        PixelKernels::copyRow(reinterpret_cast<QRgb*>(fitted.scanLine(y)),
+                              reinterpret_cast<const QRgb*>(image.constScanLine(y)), width);
+    }
+    return fitted;
+}
+
+///
+/// \brief SpriteFile::encodeFrame turn a frame's pixels into a block
+/// \param canvas the frame's canvas
+/// \param encoding set to how the block was encoded
+/// \return the block
+///
+QByteArray SpriteFile::encodeFrame(const QImage &canvas, Encoding &encoding)
+{
+    QImage image = canvas.format() == QImage::Format_ARGB32 ? canvas : canvas.convertToFormat(QImage::Format_ARGB32);
+    int rowBytes = image.width() * (int)sizeof(QRgb);
+    QByteArray raw(rowBytes * image.height(), Qt::Uninitialized);
+    for (int y = 0; y < image.height(); y++)
+    {
+        qToLittleEndian<quint32>(image.constScanLine(y), image.width(), raw.data() + y * rowBytes);
+    }
+
+    //Keep the compressed block only if it actually saves space
+    QByteArray compressed = qCompress(raw, COMPRESSION_LEVEL);
+    if (compressed.size() < raw.size())
+    {
+        encoding = Encoding::Zlib;
+        return compressed;
+    }
+    encoding = Encoding::Raw;
+    return raw;
+}
+
+///
+/// \brief SpriteFile::decodeFrame turn a block back into a frame's pixels
+/// \param block the block
+/// \param encoding how the block was encoded; not Encoding::Delta
+/// \param frameSize size of the frame
+/// \return ARGB32 canvas, or a null image if the block is damaged
+///
+QImage SpriteFile::decodeFrame(const QByteArray &block, Encoding encoding, const QSize &frameSize)
+{
+    QByteArray raw;
+    switch (encoding)
+    {
+        case Encoding::Raw:
+            raw = block;
+            break;
+        case Encoding::Zlib:
+            raw = qUncompress(block);
+            break;
+        case Encoding::Delta:
+            // needs its base frame; see decodeBlock
+            return QImage();
+    }
+
+    int rowBytes = frameSize.width() * (int)sizeof(QRgb);
+    if (frameSize.isEmpty() || raw.size() != (qint64)rowBytes * frameSize.height())
+    {
+        return QImage();
+    }
+
+    QImage image(frameSize, QImage::Format_ARGB32);
+    for (int y = 0; y < image.height(); y++)
+    {
+        qFromLittleEndian<quint32>(raw.constData() + y * rowBytes, image.width(), image.scanLine(y));
+    }
+    return image;
+}
+
+///
+/// \brief SpriteFile::decodeBlock decompress a block of any encoding. Safe to call from any thread.
+/// \param block the block
+/// \param encoding how the block was encoded
+/// \param frameSize size of the frame
+/// \return the decoded block; for a delta, pass it to applyDelta with its base frame
+///
+SpriteFile::DecodedBlock SpriteFile::decodeBlock(const QByteArray &block, Encoding encoding, const QSize &frameSize)
+{
+    DecodedBlock decoded;
+    if (encoding != Encoding::Delta)
+    {
+        decoded.image = decodeFrame(block, encoding, frameSize);
+        decoded.valid = !decoded.image.isNull();
+        return decoded;
+    }
+
+    if (block.size() < DELTA_HEADER_SIZE)
+    {
+        return decoded;
+    }
+    QDataStream in(block);
+    in.setByteOrder(QDataStream::LittleEndian);
+    quint8 baseEncoding, reserved8;
+    quint16 reserved16;
+    quint32 x, y, width, height;
+    in >> decoded.base.offset >> decoded.base.length >> baseEncoding >> reserved8 >> reserved16 >> x >> y >> width >> height;
+    decoded.base.encoding = (Encoding)baseEncoding;
+    if (baseEncoding > (quint8)Encoding::Delta
+        || (quint64)x + width > (quint64)frameSize.width() || (quint64)y + height > (quint64)frameSize.height())
+    {
+        return decoded;
+    }
+    decoded.delta = true;
+    decoded.position = QPoint(x, y);
+
+    if (width > 0 && height > 0)
+    {
+        QByteArray raw = qUncompress(reinterpret_cast<const uchar*>(block.constData()) + DELTA_HEADER_SIZE,
+                                     block.size() - DELTA_HEADER_SIZE);
+        decoded.image = decodeFrame(raw, Encoding::Raw, QSize(width, height));
+        if (decoded.image.isNull())
+        {
+            return decoded;
+        }
+    }
+    decoded.valid = true;
+    return decoded;
+}
+
+///
+/// \brief SpriteFile::applyDelta rebuild a frame stored as a delta
+/// \param base the base frame's canvas
+/// \param delta the frame's block, from decodeBlock
+/// \return ARGB32 canvas
+///
+QImage SpriteFile::applyDelta(const QImage &base, const DecodedBlock &delta)
+{
+    QImage image = base;
+    for (int y = 0; y < delta.image.height(); y++)
+    {
+        // scanLine detaches image from base on the first row
+        PixelKernels::xorRow(reinterpret_cast<QRgb*>(image.scanLine(delta.position.y() + y)) + delta.position.x(),
+                             reinterpret_cast<const QRgb*>(delta.image.constScanLine(y)),
+                             delta.image.width());
+    }
+    return image;
+}
+
+///
+/// \brief SpriteFile::headerBytes
+/// \param header the header
+/// \return the header as it is stored in the file
+///
+QByteArray SpriteFile::headerBytes(const Header &header)
+{
+    QByteArray bytes;
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.writeRawData(MAGIC, sizeof(MAGIC));
+    out << header.version << header.flags
+        << (quint32)header.frameSize.width() << (quint32)header.frameSize.height()
+        << header.frameCount << header.indexOffset << header.generation;
+    return bytes;
+}
+
+///
+/// \brief SpriteFile::parseHeader read a header and check that it can be loaded
+/// \param bytes the first HEADER_SIZE bytes of the file
+/// \param header filled with the header
+/// \param error set to a message for the user if the header can't be loaded
+/// \return true if the header is valid
+///
+bool SpriteFile::parseHeader(const QByteArray &bytes, Header &header, QString *error)
+{
+    if (bytes.size() != HEADER_SIZE || !bytes.startsWith(QByteArray(MAGIC, sizeof(MAGIC))))
+    {
+        setError(error, "This is not a sprite file.");
+        return false;
+    }
+
+    QDataStream in(bytes);
+    in.setByteOrder(QDataStream::LittleEndian);
+    in.skipRawData(sizeof(MAGIC));
+    quint32 width, height;
+    in >> header.version >> header.flags >> width >> height >> header.frameCount >> header.indexOffset >> header.generation;
+    header.frameSize = QSize(width, height);
+
+    if (header.version > VERSION)
+    {
+        setError(error, "This sprite was saved by a newer version of the editor.");
+        return false;
+    }
+    if (width < 1 || height < 1 || width > MAX_FRAME_SIDE || height > MAX_FRAME_SIDE || header.frameCount < 1)
+    {
+        setError(error, "The sprite's size is damaged.");
+        return false;
+    }
+    return true;
+}
+
+///
+/// \brief SpriteFile::tableBytes
+/// \param entries one entry per frame, in order
+/// \return the frame table as it is stored in the file
+///
+QByteArray SpriteFile::tableBytes(const std::vector<FrameEntry> &entries)
+{
+    QByteArray bytes;
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+    for (const FrameEntry &entry : entries)
+    {
+        out << entry.offset << entry.length << (quint8)entry.encoding << (quint8)0 << (quint16)0;
+    }
+    return bytes;
+}
+
+///
+/// \brief SpriteFile::parseTable read the frame table and check that every block lies inside the file
+/// \param bytes the frame table
+/// \param frameCount number of entries expected
+/// \param fileSize size of the whole file
+/// \param entries filled with one entry per frame
+/// \param error set to a message for the user if the table can't be loaded
+/// \return true if the table is valid
+///
+bool SpriteFile::parseTable(const QByteArray &bytes, quint32 frameCount, quint64 fileSize, std::vector<FrameEntry> &entries, QString *error)
+{
+    if (bytes.size() != (qint64)frameCount * ENTRY_SIZE)
+    {
+        setError(error, "The frame table is missing or damaged.");
+        return false;
+    }
+
+    QDataStream in(bytes);
+    in.setByteOrder(QDataStream::LittleEndian);
+    entries.resize(frameCount);
+    for (FrameEntry &entry : entries)
+    {
+        quint8 encoding, reserved8;
+        quint16 reserved16;
+        in >> entry.offset >> entry.length >> encoding >> reserved8 >> reserved16;
+        entry.encoding = (Encoding)encoding;
+        if (encoding > (quint8)Encoding::Delta || entry.offset + entry.length > fileSize)
+        {
+            setError(error, "The frame table is missing or damaged.");
+            return false;
+        }
+    }
+    return true;
+}
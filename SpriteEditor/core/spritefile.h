@@ -0,0 +1,125 @@
+#ifndef SPRITEFILE_H
+#define SPRITEFILE_H
+
+#include "animationsnapshot.h"
+#include <QByteArray>
+#include <QIODevice>
+#include <QPoint>
+#include <QString>
+#include <unordered_map>
+
+///
+/// \brief The SpriteFile class reads and writes the binary (version 2 and 3) .ssp format.
+///
+///        All numbers are little endian. The file starts with a 32 byte header:
+///          "SSPB", version (u16), flags (u16), frame width (u32), frame height (u32), frame count (u32),
+///          offset of the frame table (u64), generation (u32)
+///        followed by one block per frame, then the frame table: one 16 byte entry per frame, in order:
+///          offset of the frame's block (u64), length of the block (u32), encoding (u8), reserved (3 bytes)
+///        A block holds the frame's pixels as width*height little endian ARGB32 values, row by row, either
+///        as-is (Encoding::Raw) or passed through qCompress (Encoding::Zlib).
+///
+///        Version 3 adds Encoding::Delta, for a frame stored as its change from a base frame (the one before it
+///        when it was written). The block starts with a 32 byte delta header:
+///          the base frame's block as a 16 byte table entry, then the changed rectangle's x, y, width and height (u32)
+///        followed by the rectangle's pixels XORed with the base frame's, as little endian values passed through
+///        qCompress (nothing if the rectangle is empty). The base block is always earlier in the file, and may be a
+///        delta itself; write() starts a chain over with a whole frame at least every keyframeInterval frames.
+///
+///        Blocks may be in any order, several entries may share a block, and the file may hold blocks no entry
+///        refers to. That lets append() save an edit by adding only the changed frames' blocks and a new table
+///        to the end of the file, then pointing the header at the new table. The generation is random when a file is
+///        written whole and goes up by one with each append(), so append() can tell that a file is still the one it
+///        last wrote even if something else rewrote it to the same size; readers ignore it, and files from before it
+///        was added hold 0 there.
+///
+class SpriteFile
+{
+public:
+    static constexpr quint16 VERSION = 3;
+    static constexpr int HEADER_SIZE = 32;
+    static constexpr int ENTRY_SIZE = 16;
+    static constexpr int DELTA_HEADER_SIZE = 32;
+    static constexpr int KEYFRAME_INTERVAL = 16;
+    // largest frame side accepted when reading, to reject corrupt headers before allocating
+    static constexpr int MAX_FRAME_SIDE = 1 << 14;
+
+    enum class Encoding : quint8 { Raw = 0, Zlib = 1, Delta = 2 };
+
+    struct Header
+    {
+        quint16 version = VERSION;
+        quint16 flags = 0;
+        QSize frameSize;
+        quint32 frameCount = 0;
+        quint64 indexOffset = 0;
+        quint32 generation = 0;
+    };
+
+    struct EncodedFrame
+    {
+        QByteArray block;
+        Encoding encoding = Encoding::Raw;
+    };
+
+    struct FrameEntry
+    {
+        quint64 offset = 0;
+        quint32 length = 0;
+        Encoding encoding = Encoding::Raw;
+    };
+
+    // what a file written by write() or append() holds, so the next append() can reuse its blocks
+    struct Layout
+    {
+        quint64 fileSize = 0;
+        // the header's indexOffset and generation, which append() checks along with fileSize
+        quint64 indexOffset = 0;
+        quint32 generation = 0;
+        // bytes still used by the header, the table and the blocks it refers to; the rest is waste
+        quint64 liveBytes = 0;
+        // block holding each frame revision (see Frame::getRevision) in the file
+        std::unordered_map<quint64, FrameEntry> blocks;
+    };
+
+    // a block after decompressing, before a delta is applied to its base
+    struct DecodedBlock
+    {
+        bool valid = false;
+        // the whole frame, or for a delta the changed rectangle XORed with the base frame (null if nothing changed)
+        QImage image;
+        bool delta = false;
+        FrameEntry base;
+        QPoint position;
+    };
+
+    static bool isSpriteFile(QIODevice *device);
+
+    static bool write(QIODevice *device, const AnimationSnapshot &snapshot, QString *error = nullptr, Layout *layout = nullptr,
+                      int keyframeInterval = KEYFRAME_INTERVAL);
+    static bool append(QIODevice *device, const AnimationSnapshot &snapshot, Layout &layout, QString *error = nullptr,
+                       int keyframeInterval = KEYFRAME_INTERVAL);
+    static bool shouldCompact(const Layout &layout);
+    static Layout layoutOf(const Header &header, quint64 fileSize, const std::vector<FrameEntry> &entries,
+                           const std::vector<quint64> &revisions);
+    static bool read(QIODevice *device, AnimationSnapshot &snapshot, QString *error = nullptr);
+
+    static QImage fitToSize(const QImage &canvas, const QSize &size);
+    static QByteArray encodeFrame(const QImage &canvas, Encoding &encoding);
+    static QImage decodeFrame(const QByteArray &block, Encoding encoding, const QSize &frameSize);
+    static DecodedBlock decodeBlock(const QByteArray &block, Encoding encoding, const QSize &frameSize);
+    static QImage applyDelta(const QImage &base, const DecodedBlock &delta);
+
+    static bool parseHeader(const QByteArray &bytes, Header &header, QString *error);
+    static bool parseTable(const QByteArray &bytes, quint32 frameCount, quint64 fileSize, std::vector<FrameEntry> &entries, QString *error);
+
+private:
+    static QList<EncodedFrame> encodeBlocks(const AnimationSnapshot &snapshot, Layout &layout, std::vector<FrameEntry> &entries,
+                                            int keyframeInterval);
+    static QByteArray encodeDelta(const QImage &canvas, const QImage &base);
+    static quint16 versionFor(const QList<EncodedFrame> &blocks);
+    static QByteArray headerBytes(const Header &header);
+    static QByteArray tableBytes(const std::vector<FrameEntry> &entries);
+};
+
+#endif // SPRITEFILE_H
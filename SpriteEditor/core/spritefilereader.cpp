@@ -0,0 +1,186 @@
+#include "spritefilereader.h"
+#include <algorithm>
+
+// how many decoded blocks a reader keeps
+static const int RECENTLY_DECODED_COUNT = 4;
+
+///
+/// \brief SpriteFileReader::SpriteFileReader constructor. Use open() to make a reader.
+/// \param filename file to read
+///
+SpriteFileReader::SpriteFileReader(const QString &filename)
+    : file(filename)
+{
+
+}
+
+///
+/// \brief SpriteFileReader::open map a binary .ssp file and read its header and frame table
+/// \param filename file to read
+/// \param error set to a message for the user if the file can't be opened this way
+/// \return the reader, or nullptr on failure (including if the file can't be mapped; reading it with
+///         SpriteFile::read may still work)
+///
+std::shared_ptr<SpriteFileReader> SpriteFileReader::open(const QString &filename, QString *error)
+{
+    std::shared_ptr<SpriteFileReader> reader(new SpriteFileReader(filename));
+    QFile &file = reader->file;
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        if (error)
+        {
+            *error = file.errorString();
+        }
+        return nullptr;
+    }
+
+    qint64 fileSize = file.size();
+    reader->mapped = file.map(0, fileSize);
+    if (!reader->mapped)
+    {
+        if (error)
+        {
+            *error = file.errorString();
+        }
+        return nullptr;
+    }
+
+    //Only the header and the table are touched here; the OS pages in frame blocks as they are decoded
+    QByteArray headerBytes = QByteArray::fromRawData(reinterpret_cast<const char*>(reader->mapped),
+                                                     std::min<qint64>(fileSize, SpriteFile::HEADER_SIZE));
+    if (!SpriteFile::parseHeader(headerBytes, reader->header, error))
+    {
+        return nullptr;
+    }
+
+    quint64 tableLength = (quint64)reader->header.frameCount * SpriteFile::ENTRY_SIZE;
+    if (reader->header.indexOffset + tableLength > (quint64)fileSize)
+    {
+        if (error)
+        {
+            *error = "The frame table is missing or damaged.";
+        }
+        return nullptr;
+    }
+    QByteArray tableBytes = QByteArray::fromRawData(reinterpret_cast<const char*>(reader->mapped + reader->header.indexOffset),
+                                                    tableLength);
+    if (!SpriteFile::parseTable(tableBytes, reader->header.frameCount, fileSize, reader->entries, error))
+    {
+        return nullptr;
+    }
+    return reader;
+}
+
+///
+/// \brief SpriteFileReader::getFrameSize
+/// \return size of every frame in the file
+///
+QSize SpriteFileReader::getFrameSize() const
+{
+    return header.frameSize;
+}
+
+///
+/// \brief SpriteFileReader::getFrameCount
+/// \return number of frames in the file
+///
+int SpriteFileReader::getFrameCount() const
+{
+    return entries.size();
+}
+
+///
+/// \brief SpriteFileReader::layoutFor describe the file for SpriteFile::append
+/// \param revisions revision of the frame each of the file's frames was loaded into
+/// \return the layout
+///
+SpriteFile::Layout SpriteFileReader::layoutFor(const std::vector<quint64> &revisions) const
+{
+    return SpriteFile::layoutOf(header, file.size(), entries, revisions);
+}
+
+///
+/// \brief SpriteFileReader::decodeFrame decode one frame. Safe to call from any thread.
+/// \param index which frame, from 0 to getFrameCount() - 1
+/// \return ARGB32 canvas, or a null image if the frame's block is damaged
+///
+QImage SpriteFileReader::decodeFrame(int index) const
+{
+    return decodeBlock(entries[index]);
+}
+
+///
+/// \brief SpriteFileReader::decodeBlock decode a block, following a delta back through its bases to a whole frame
+/// \param entry the block
+/// \return ARGB32 canvas, or a null image if a block on the way is damaged
+///
+QImage SpriteFileReader::decodeBlock(const SpriteFile::FrameEntry &entry) const
+{
+    std::vector<SpriteFile::DecodedBlock> deltas;
+    SpriteFile::FrameEntry next = entry;
+    QImage image;
+    while (!findDecoded(next.offset, image))
+    {
+        if (next.offset + next.length > (quint64)file.size())
+        {
+            return QImage();
+        }
+        //fromRawData doesn't copy, so a raw block is read straight from the mapping
+        QByteArray block = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped + next.offset), next.length);
+        SpriteFile::DecodedBlock decoded = SpriteFile::decodeBlock(block, next.encoding, header.frameSize);
+        // a base is always earlier in the file, so following bases always ends
+        if (!decoded.valid || (decoded.delta && decoded.base.offset >= next.offset))
+        {
+            return QImage();
+        }
+        if (!decoded.delta)
+        {
+            image = decoded.image;
+            break;
+        }
+        next = decoded.base;
+        deltas.push_back(std::move(decoded));
+    }
+
+    for (auto delta = deltas.crbegin(); delta != deltas.crend(); delta++)
+    {
+        image = SpriteFile::applyDelta(image, *delta);
+    }
+    rememberDecoded(entry.offset, image);
+    return image;
+}
+
+///
+/// \brief SpriteFileReader::findDecoded look for a block among the ones decoded last
+/// \param offset the block's offset
+/// \param image set to the block's frame if it was found
+/// \return true if it was found
+///
+bool SpriteFileReader::findDecoded(quint64 offset, QImage &image) const
+{
+    QMutexLocker lock(&decodedMutex);
+    for (const QPair<quint64, QImage> &decoded : recentlyDecoded)
+    {
+        if (decoded.first == offset)
+        {
+            image = decoded.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+///
+/// \brief SpriteFileReader::rememberDecoded keep a decoded block, in case the next frame is a delta from it
+/// \param offset the block's offset
+/// \param image the block's frame
+///
+void SpriteFileReader::rememberDecoded(quint64 offset, const QImage &image) const
+{
+    QMutexLocker lock(&decodedMutex);
+    recentlyDecoded.prepend(qMakePair(offset, image));
+    while (recentlyDecoded.size() > RECENTLY_DECODED_COUNT)
+    {
+        recentlyDecoded.removeLast();
+    }
+}
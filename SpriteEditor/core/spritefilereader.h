@@ -0,0 +1,46 @@
+#ifndef SPRITEFILEREADER_H
+#define SPRITEFILEREADER_H
+
+#include <memory>
+#include <QFile>
+#include <QImage>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include "spritefile.h"
+#include <vector>
+
+///
+/// \brief The SpriteFileReader class opens a binary .ssp file by mapping it into memory and reading only its
+///        header and frame table. Frames are decoded one at a time when asked for, straight out of the mapping,
+///        so opening a file costs the same however many frames it has. The last few frames decoded are kept, so
+///        frames stored as deltas decode quickly in order.
+///
+class SpriteFileReader
+{
+public:
+    static std::shared_ptr<SpriteFileReader> open(const QString &filename, QString *error = nullptr);
+
+    QSize getFrameSize() const;
+    int getFrameCount() const;
+    QImage decodeFrame(int index) const;
+    SpriteFile::Layout layoutFor(const std::vector<quint64> &revisions) const;
+
+private:
+    SpriteFileReader(const QString &filename);
+
+    QImage decodeBlock(const SpriteFile::FrameEntry &entry) const;
+    bool findDecoded(quint64 offset, QImage &image) const;
+    void rememberDecoded(quint64 offset, const QImage &image) const;
+
+    QFile file;
+    const uchar *mapped = nullptr;
+    SpriteFile::Header header;
+    std::vector<SpriteFile::FrameEntry> entries;
+
+    // most recently decoded blocks, newest first, by offset
+    mutable QMutex decodedMutex;
+    mutable QList<QPair<quint64, QImage>> recentlyDecoded;
+};
+
+#endif // SPRITEFILEREADER_H
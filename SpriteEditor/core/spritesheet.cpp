@@ -0,0 +1,236 @@
+#include "spritesheet.h"
+#include "fileerror.h"
+#include "pixelkernels.h"
+#include <algorithm>
+#include <numeric>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <QXmlStreamWriter>
+#include <vector>
+
+// QImage's PNG quality; 80 makes zlib use its fastest level, which pixel art compresses well at
+static const int PNG_QUALITY = 80;
+
+///
+/// \brief SpriteSheet::SpriteSheet work out a sheet's layout
+/// \param frameSize size of every frame
+/// \param frameCount number of frames
+/// \param options the layout asked for; columns win over rows, and a sheet always has room for every frame
+///
+SpriteSheet::SpriteSheet(const QSize &frameSize, int frameCount, const Options &options)
+    : frameSize(frameSize),
+      frameCount(std::max(frameCount, 0)),
+      padding(std::max(options.padding, 0))
+{
+    int count = std::max(this->frameCount, 1);
+    if (options.columns > 0)
+    {
+        columns = std::min(options.columns, count);
+    }
+    else if (options.rows > 0)
+    {
+        columns = (count + std::min(options.rows, count) - 1) / std::min(options.rows, count);
+    }
+    else
+    {
+        columns = count;
+    }
+    rows = (count + columns - 1) / columns;
+}
+
+///
+/// \brief SpriteSheet::getSize
+/// \return size of the whole sheet, padding included
+///
+QSize SpriteSheet::getSize() const
+{
+    return QSize(padding + columns * (frameSize.width() + padding), padding + rows * (frameSize.height() + padding));
+}
+
+///
+/// \brief SpriteSheet::getColumns
+/// \return frames per row
+///
+int SpriteSheet::getColumns() const
+{
+    return columns;
+}
+
+///
+/// \brief SpriteSheet::getRows
+/// \return rows of frames
+///
+int SpriteSheet::getRows() const
+{
+    return rows;
+}
+
+///
+/// \brief SpriteSheet::frameRect where a frame goes on the sheet
+/// \param index which frame
+/// \return the frame's area of the sheet
+///
+QRect SpriteSheet::frameRect(int index) const
+{
+    return QRect(QPoint(padding + index % columns * (frameSize.width() + padding),
+                        padding + index / columns * (frameSize.height() + padding)),
+                 frameSize);
+}
+
+///
+/// \brief SpriteSheet::compose draw every frame onto one image. Frames are copied on the thread pool, each into its
+///        own part of the sheet.
+/// \param snapshot the animation; its size and frame count must be the ones the sheet was laid out for, and every
+///        frame must have its pixels
+/// \return ARGB32 sheet, transparent outside the frames
+///
+QImage SpriteSheet::compose(const AnimationSnapshot &snapshot) const
+{
+    if (frameCount == 0 || frameSize.isEmpty())
+    {
+        return QImage();
+    }
+
+    QImage sheet(getSize(), QImage::Format_ARGB32);
+    sheet.fill(Qt::transparent);
+    // bits() detaches once here, so the workers can all write through the same pointer
+    uchar *bits = sheet.bits();
+    qsizetype bytesPerLine = sheet.bytesPerLine();
+
+    std::vector<int> indices(std::min<size_t>(frameCount, snapshot.frames.size()));
+    std::iota(indices.begin(), indices.end(), 0);
+    QtConcurrent::blockingMap(indices, [this, &snapshot, bits, bytesPerLine](int index)
+    {
+        const QImage &canvas = snapshot.frames[index];
+        QImage frame = canvas.format() == QImage::Format_ARGB32 ? canvas : canvas.convertToFormat(QImage::Format_ARGB32);
+        QRect target = frameRect(index);
+        int width = std::min(frame.width(), target.width());
+        for (int y = 0; y < std::min(frame.height(), target.height()); y++)
+        {
+            PixelKernels::copyRow(reinterpret_cast<QRgb*>(bits + (target.y() + y) * bytesPerLine) + target.x(),
+                                  reinterpret_cast<const QRgb*>(frame.constScanLine(y)), width);
+        }
+    });
+    return sheet;
+}
+
+///
+/// \brief SpriteSheet::metadata describe the sheet for the tool that will read it
+/// \param format Metadata::Json or Metadata::Xml
+/// \param imageName name of the sheet's image file, as the metadata should refer to it
+/// \return the file's contents; every rectangle is in pixels, from the sheet's top left corner
+///
+QByteArray SpriteSheet::metadata(Metadata format, const QString &imageName) const
+{
+    QSize size = getSize();
+    if (format == Metadata::Json)
+    {
+        QJsonArray frames;
+        for (int i = 0; i < frameCount; i++)
+        {
+            QRect rect = frameRect(i);
+            frames.append(QJsonObject{ { "x", rect.x() }, { "y", rect.y() },
+                                       { "width", rect.width() }, { "height", rect.height() } });
+        }
+        QJsonObject json{ { "image", imageName }, { "width", size.width() }, { "height", size.height() },
+                          { "frameWidth", frameSize.width() }, { "frameHeight", frameSize.height() },
+                          { "columns", columns }, { "rows", rows }, { "padding", padding },
+                          { "frames", frames } };
+        return QJsonDocument(json).toJson(QJsonDocument::Indented);
+    }
+
+    QByteArray text;
+    QXmlStreamWriter xml(&text);
+    xml.setAutoFormatting(true);
+    xml.writeStartDocument();
+    xml.writeStartElement("spritesheet");
+    xml.writeAttribute("image", imageName);
+    xml.writeAttribute("width", QString::number(size.width()));
+    xml.writeAttribute("height", QString::number(size.height()));
+    xml.writeAttribute("frameWidth", QString::number(frameSize.width()));
+    xml.writeAttribute("frameHeight", QString::number(frameSize.height()));
+    xml.writeAttribute("columns", QString::number(columns));
+    xml.writeAttribute("rows", QString::number(rows));
+    xml.writeAttribute("padding", QString::number(padding));
+    for (int i = 0; i < frameCount; i++)
+    {
+        QRect rect = frameRect(i);
+        xml.writeEmptyElement("frame");
+        xml.writeAttribute("index", QString::number(i));
+        xml.writeAttribute("x", QString::number(rect.x()));
+        xml.writeAttribute("y", QString::number(rect.y()));
+        xml.writeAttribute("width", QString::number(rect.width()));
+        xml.writeAttribute("height", QString::number(rect.height()));
+    }
+    xml.writeEndElement();
+    xml.writeEndDocument();
+    return text;
+}
+
+///
+/// \brief SpriteSheet::metadataPath where write() puts the metadata for a sheet
+/// \param filename the sheet's image file
+/// \param format Metadata::Json or Metadata::Xml
+/// \return the image's path with its extension replaced by .json or .xml
+///
+QString SpriteSheet::metadataPath(const QString &filename, Metadata format)
+{
+    QFileInfo info(filename);
+    return info.dir().filePath(info.completeBaseName() + (format == Metadata::Json ? ".json" : ".xml"));
+}
+
+///
+/// \brief SpriteSheet::write compose a sheet and save it as a PNG, with its metadata next to it if asked for.
+///        Safe to call from any thread, so the PNG can be compressed off the UI thread.
+/// \param filename the image file to write
+/// \param snapshot the animation; every frame must have its pixels
+/// \param options the layout, and which metadata to write
+/// \param error set to a message for the user if writing fails
+/// \return true if written successfully
+///
+bool SpriteSheet::write(const QString &filename, const AnimationSnapshot &snapshot, const Options &options,
+                        QString *error)
+{
+    SpriteSheet sheet(snapshot.frameSize, snapshot.frames.size(), options);
+    QImage image = sheet.compose(snapshot);
+    if (image.isNull())
+    {
+        setError(error, "There are no frames to export.");
+        return false;
+    }
+
+    // QSaveFile only replaces the target on commit, so a failed export never leaves half a file behind
+    QSaveFile imageFile(filename);
+    if (!imageFile.open(QIODevice::WriteOnly))
+    {
+        setError(error, imageFile.errorString());
+        return false;
+    }
+    if (!image.save(&imageFile, "PNG", PNG_QUALITY))
+    {
+        setError(error, "Unable to write the image.");
+        return false;
+    }
+    if (!imageFile.commit())
+    {
+        setError(error, imageFile.errorString());
+        return false;
+    }
+
+    if (options.metadata != Metadata::None)
+    {
+        QSaveFile metadataFile(metadataPath(filename, options.metadata));
+        QByteArray text = sheet.metadata(options.metadata, QFileInfo(filename).fileName());
+        if (!metadataFile.open(QIODevice::WriteOnly) || metadataFile.write(text) != text.size() || !metadataFile.commit())
+        {
+            setError(error, metadataFile.errorString());
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef SPRITESHEET_H
+#define SPRITESHEET_H
+
+#include "animationsnapshot.h"
+#include <QByteArray>
+#include <QImage>
+#include <QRect>
+#include <QString>
+
+///
+/// \brief The SpriteSheet class lays an animation's frames out on one image, in order, left to right and then top to
+///        bottom, for game engines and other tools that take a single texture. Frames are separated from each other
+///        and from the edges by the padding, so filtering never bleeds one frame into the next. Alongside the image
+///        a metadata file (JSON or XML) can list the sheet's layout and where each frame is on it.
+///
+class SpriteSheet
+{
+public:
+    enum class Metadata { None, Json, Xml };
+
+    struct Options
+    {
+        // frames per row; 0 to work it out from rows
+        int columns = 0;
+        // rows of frames, used only when columns is 0; 0 with columns 0 puts every frame in one row
+        int rows = 0;
+        // transparent pixels between frames and around the edge
+        int padding = 0;
+        Metadata metadata = Metadata::None;
+    };
+
+    SpriteSheet(const QSize &frameSize, int frameCount, const Options &options);
+
+    QSize getSize() const;
+    int getColumns() const;
+    int getRows() const;
+    QRect frameRect(int index) const;
+
+    QImage compose(const AnimationSnapshot &snapshot) const;
+    QByteArray metadata(Metadata format, const QString &imageName) const;
+
+    static bool write(const QString &filename, const AnimationSnapshot &snapshot, const Options &options,
+                      QString *error = nullptr);
+    static QString metadataPath(const QString &filename, Metadata format);
+
+private:
+    QSize frameSize;
+    int frameCount;
+    int columns;
+    int rows;
+    int padding;
+};
+
+#endif // SPRITESHEET_H
@@ -0,0 +1,168 @@
+#include "stencil.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+///
+/// \brief Stencil::Stencil constructor, making an empty stencil
+/// \param area area of the canvas the stencil covers
+///
+Stencil::Stencil(const QRect &area)
+    : bounds(area.isValid() ? area : QRect()),
+      mask(bounds.width() * bounds.height(), 0)
+{
+
+}
+
+///
+/// \brief Stencil::forPolyline make a stencil of connected lines with toolSize thickness through the given points
+/// \param clip area the stencil is limited to (normally the canvas)
+/// \param toolSize the size of the lines
+/// \param points the points to connect, in order; a single point is stamped on its own
+/// \return Stencil covering only the polyline's bounding box
+///
+Stencil Stencil::forPolyline(const QRect &clip, int toolSize, const QPolygon &points)
+{
+    if (points.isEmpty())
+    {
+        return Stencil(QRect());
+    }
+    QRect pointBounds = points.boundingRect();
+    QRect lineBounds(pointBounds.topLeft(), pointBounds.bottomRight() + QPoint(toolSize - 1, toolSize - 1));
+    Stencil stencil(lineBounds & clip);
+    //Polylines entirely on the canvas (almost all of them) never need their stamps clamped
+    if (clip.contains(lineBounds))
+    {
+        stencil.stampPolyline<false>(toolSize, points);
+    }
+    else
+    {
+        stencil.stampPolyline<true>(toolSize, points);
+    }
+    return stencil;
+}
+
+///
+/// \brief Stencil::stamp mark a size by size square with its top left corner at (x,y)
+/// \param x x coordinate of the square
+/// \param y y coordinate of the square
+/// \param size width and height of the square
+///
+template <bool Clip>
+void Stencil::stamp(int x, int y, int size)
+{
+    int left = x;
+    int right = x + size - 1;
+    int top = y;
+    int bottom = y + size - 1;
+    if constexpr (Clip)
+    {
+        left = std::max(left, bounds.left());
+        right = std::min(right, bounds.right());
+        top = std::max(top, bounds.top());
+        bottom = std::min(bottom, bounds.bottom());
+        if (left > right)
+        {
+            return;
+        }
+    }
+
+    for (int row = top; row <= bottom; row++)
+    {
+        std::memset(&mask[(row - bounds.top()) * bounds.width() + (left - bounds.left())], 1, right - left + 1);
+    }
+}
+
+///
+/// \brief Stencil::stampLine walk the line between two points (Bresenham) and stamp the tool at every step
+/// \param size the size of the tool
+/// \param x1 x coordinate of the first point
+/// \param y1 y coordinate of the first point
+/// \param x2 x coordinate of the second point
+/// \param y2 y coordinate of the second point
+///
+template <bool Clip>
+void Stencil::stampLine(int size, int x1, int y1, int x2, int y2)
+{
+    int dx = std::abs(x2 - x1);
+    int dy = -std::abs(y2 - y1);
+    int stepX = x1 < x2 ? 1 : -1;
+    int stepY = y1 < y2 ? 1 : -1;
+    int error = dx + dy;
+    int x = x1;
+    int y = y1;
+    while (true)
+    {
+        stamp<Clip>(x, y, size);
+        if (x == x2 && y == y2)
+        {
+            break;
+        }
+        int doubled = 2 * error;
+        if (doubled >= dy)
+        {
+            error += dy;
+            x += stepX;
+        }
+        if (doubled <= dx)
+        {
+            error += dx;
+            y += stepY;
+        }
+    }
+}
+
+///
+/// \brief Stencil::stampPolyline stamp the tool along every segment of a polyline
+/// \param size the size of the tool
+/// \param points the points to connect, in order; a single point is stamped on its own
+///
+template <bool Clip>
+void Stencil::stampPolyline(int size, const QPolygon &points)
+{
+    if (points.size() == 1)
+    {
+        stamp<Clip>(points[0].x(), points[0].y(), size);
+    }
+    for (int i = 1; i < points.size(); i++)
+    {
+        stampLine<Clip>(size, points[i - 1].x(), points[i - 1].y(), points[i].x(), points[i].y());
+    }
+}
+
+template void Stencil::stamp<true>(int x, int y, int size);
+template void Stencil::stamp<false>(int x, int y, int size);
+template void Stencil::stampLine<true>(int size, int x1, int y1, int x2, int y2);
+template void Stencil::stampLine<false>(int size, int x1, int y1, int x2, int y2);
+template void Stencil::stampPolyline<true>(int size, const QPolygon &points);
+template void Stencil::stampPolyline<false>(int size, const QPolygon &points);
+
+///
+/// \brief Stencil::getBounds
+/// \return area of the canvas the stencil covers
+///
+QRect Stencil::getBounds() const
+{
+    return bounds;
+}
+
+///
+/// \brief Stencil::row get the mask for one row of the canvas
+/// \param y canvas row, which must be inside getBounds()
+/// \return one flag per pixel, indexed from getBounds().left(); nonzero where the tool covers the pixel
+///
+const uchar *Stencil::row(int y) const
+{
+    return &mask[(y - bounds.top()) * bounds.width()];
+}
+
+///
+/// \brief Stencil::contains
+/// \param x x coordinate on the canvas
+/// \param y y coordinate on the canvas
+/// \return true iff the tool covers the pixel at (x,y)
+///
+bool Stencil::contains(int x, int y) const
+{
+    return bounds.contains(x, y) && row(y)[x - bounds.left()] != 0;
+}
@@ -0,0 +1,34 @@
+#ifndef STENCIL_H
+#define STENCIL_H
+
+#include <QPolygon>
+#include <QRect>
+#include <vector>
+
+///
+/// \brief The Stencil class is a mask of the pixels covered by a tool, stored only for the bounding box of
+///        those pixels so that tools never have to touch the rest of the canvas.
+///
+class Stencil
+{
+    QRect bounds;
+    std::vector<uchar> mask;
+
+public:
+    Stencil(const QRect &area);
+    static Stencil forPolyline(const QRect &clip, int toolSize, const QPolygon &points);
+
+    // Clip = false skips clamping to getBounds(); only use it when every stamp is known to lie inside
+    template <bool Clip = true>
+    void stamp(int x, int y, int size);
+    template <bool Clip = true>
+    void stampLine(int size, int x1, int y1, int x2, int y2);
+    template <bool Clip = true>
+    void stampPolyline(int size, const QPolygon &points);
+
+    QRect getBounds() const;
+    const uchar *row(int y) const;
+    bool contains(int x, int y) const;
+};
+
+#endif // STENCIL_H
@@ -0,0 +1,30 @@
+//Code style reviewed by Cameron Wortmann 4/5/2023
+#include "tool.h"
+
+///
+/// \brief Tool::polylineStencil Returns a stencil of connected lines with lineSize thickness through the given points,
+///        covering only the polyline's bounding box on the canvas.
+/// \param canvas QImage that the lines are going to be drawn on
+/// \param lineSize the size of the lines
+/// \param points the points to connect, in order
+/// \return Stencil of the polyline, clipped to the canvas.
+///
+Stencil Tool::polylineStencil(const QImage &canvas, int lineSize, const QPolygon &points)
+{
+    return Stencil::forPolyline(canvas.rect(), lineSize, points);
+}
+
+///
+/// \brief Tool::useToolOnLine Uses the tool at all points between points with coordinates (x1,y1) and (x2.y2)
+/// \param frame to use the tool on
+/// \param paintSettings Settings for the tool, including color, dithering, and tool size.
+/// \param x1 x coordinate of one point of the line
+/// \param y1 y coordinate of one point of the line
+/// \param x2 x coordinate of other point of the line
+/// \param y2 y coordinate of other point of the line.
+///
+void Tool::useToolOnLine(const std::shared_ptr<Frame> &frame, const Paint &paintSettings, int x1, int y1, int x2, int y2)
+{
+    //A line is a polyline with two points
+    useToolOnPolyline(frame, paintSettings, QPolygon({ QPoint(x1, y1), QPoint(x2, y2) }));
+}
@@ -0,0 +1,26 @@
+#ifndef TOOL_H
+#define TOOL_H
+
+#include <algorithm>
+#include "frame.h"
+#include <memory>
+#include "paint.h"
+#include "stencil.h"
+#include "toolkernels.h"
+
+///
+/// \brief The tool class defines methods that tools must implement.
+/// \author Nickolas Solum
+/// code style reviewed by Cameron Wortmann 4/5/2023
+///
+class Tool
+{
+protected:
+    Stencil polylineStencil(const QImage &canvas, int toolSize, const QPolygon &points);
+public:
+    virtual void useToolAtPoint(const std::shared_ptr<Frame> &frame, const Paint &color, int x, int y) = 0;
+    virtual void useToolOnPolyline(const std::shared_ptr<Frame> &frame, const Paint &color, const QPolygon &points) = 0;
+    void useToolOnLine(const std::shared_ptr<Frame> &frame, const Paint &color, int x1, int y1, int x2, int y2);
+};
+
+#endif // TOOL_H
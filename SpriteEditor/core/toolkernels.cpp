@@ -0,0 +1,80 @@
+#include "toolkernels.h"
+#include "ditherpattern.h"
+#include "pixelkernels.h"
+#include "stencil.h"
+
+///
+/// \brief blendRow write one row of a stencil onto the canvas
+/// \param dst canvas pixel at (x,y)
+/// \param mask stencil row, starting at x
+/// \param x X coordinate of dst
+/// \param y Y coordinate of dst
+/// \param count number of pixels
+/// \param pattern what the tool paints with; only colorAt(0, 0) is read when Pattern is Solid
+///
+template <BlendMode Blend, PatternMode Pattern>
+static void blendRow(QRgb *dst, const uchar *mask, int x, int y, int count, const DitherPattern &pattern)
+{
+    if constexpr (Blend == BlendMode::Erase)
+    {
+        PixelKernels::eraseRowMasked(dst, mask, count);
+    }
+    else if constexpr (Blend == BlendMode::Replace && Pattern == PatternMode::Solid)
+    {
+        PixelKernels::fillRowMasked(dst, mask, count, pattern.colorAt(0, 0));
+    }
+    else
+    {
+        pattern.fillRowMasked(dst, mask, x, y, count);
+    }
+}
+
+///
+/// \brief applyStencilAs write every row of a stencil onto the canvas with one kernel
+/// \param canvas ARGB32 image the stencil lies inside
+/// \param stencil pixels to write
+/// \param pattern what the tool paints with
+///
+template <BlendMode Blend, PatternMode Pattern>
+static void applyStencilAs(QImage &canvas, const Stencil &stencil, const DitherPattern &pattern)
+{
+    QRect bounds = stencil.getBounds();
+    for (int y = bounds.top(); y <= bounds.bottom(); y++)
+    {
+        QRgb *line = reinterpret_cast<QRgb*>(canvas.scanLine(y));
+        blendRow<Blend, Pattern>(line + bounds.left(), stencil.row(y), bounds.left(), y, bounds.width(), pattern);
+    }
+}
+
+///
+/// \brief ToolKernels::applyStencil pick the kernel for a blend mode and pattern, then write the stencil with it
+/// \param canvas ARGB32 image the stencil lies inside
+/// \param stencil pixels to write
+/// \param blend how to combine the pattern with the canvas
+/// \param pattern what the tool paints with (ignored when erasing)
+///
+void ToolKernels::applyStencil(QImage &canvas, const Stencil &stencil, BlendMode blend, const DitherPattern &pattern)
+{
+    if (stencil.getBounds().isEmpty())
+    {
+        return;
+    }
+
+    bool solid = pattern.isSolid();
+    switch (blend)
+    {
+        case BlendMode::Replace:
+            if (solid)
+            {
+                applyStencilAs<BlendMode::Replace, PatternMode::Solid>(canvas, stencil, pattern);
+            }
+            else
+            {
+                applyStencilAs<BlendMode::Replace, PatternMode::Dither>(canvas, stencil, pattern);
+            }
+            break;
+        case BlendMode::Erase:
+            applyStencilAs<BlendMode::Erase, PatternMode::Solid>(canvas, stencil, pattern);
+            break;
+    }
+}
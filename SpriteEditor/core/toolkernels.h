@@ -0,0 +1,30 @@
+#ifndef TOOLKERNELS_H
+#define TOOLKERNELS_H
+
+#include <QImage>
+
+class DitherPattern;
+class Stencil;
+
+///
+/// \brief How a tool combines its pattern with the pixels already on the canvas.
+///
+enum class BlendMode { Replace, Erase };
+
+///
+/// \brief Whether the pattern a tool writes is one color or has to be read out of the pattern's tile.
+///
+enum class PatternMode { Solid, Dither };
+
+///
+/// \brief The ToolKernels class writes a tool's stencil onto a canvas. The inner loops are templates on
+///        BlendMode and PatternMode, so the choice between them is made once per stroke segment and the
+///        per-pixel code has no branches on either.
+///
+class ToolKernels
+{
+public:
+    static void applyStencil(QImage &canvas, const Stencil &stencil, BlendMode blend, const DitherPattern &pattern);
+};
+
+#endif // TOOLKERNELS_H
@@ -0,0 +1,450 @@
+#include "undohistory.h"
+#include <QDataStream>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <algorithm>
+
+///
+/// \brief UndoHistory::Entry::Entry constructor.
+/// \param _id identifier used to find the entry again when background work finishes
+/// \param _state the change this entry holds
+///
+UndoHistory::Entry::Entry(quint64 _id, UndoState _state)
+    : id(_id),
+      state(std::move(_state))
+{
+
+}
+
+///
+/// \brief UndoHistory::UndoHistory constructor.
+/// \param parent used by Qt
+///
+UndoHistory::UndoHistory(QObject *parent)
+    : QObject(parent)
+{
+
+}
+
+///
+/// \brief UndoHistory::push add a new state after the current position, discarding any redo states
+/// \param state UndoState representing the user's change
+///
+void UndoHistory::push(UndoState state)
+{
+    entries.erase(entries.begin() + index, entries.end());
+
+    Entry entry(nextId++, std::move(state));
+    for(const QImage &image : payloadOf(entry.state))
+        entry.rawBytes += image.sizeInBytes();
+    entries.push_back(std::move(entry));
+    index = entries.size();
+
+    rebalance();
+}
+
+///
+/// \brief UndoHistory::clear throw away all states, including the journal on disk
+///
+void UndoHistory::clear()
+{
+    entries.clear();
+    index = 0;
+    if(journal.isOpen())
+        journal.resize(0);
+
+    emit memoryUsageChanged(getMemoryUsage());
+}
+
+///
+/// \brief UndoHistory::canUndo
+/// \return true if there is a state before the current position
+///
+bool UndoHistory::canUndo() const
+{
+    return index > 0;
+}
+
+///
+/// \brief UndoHistory::canRedo
+/// \return true if there is a state after the current position
+///
+bool UndoHistory::canRedo() const
+{
+    return index < entries.size();
+}
+
+///
+/// \brief UndoHistory::undo step back over the most recent state. Only call if canUndo() is true.
+/// \return the state to revert, or nothing if its pixel data could not be read back (restoreFailed is emitted and
+///         the position is unchanged)
+///
+std::optional<UndoState> UndoHistory::undo()
+{
+    QString error;
+    if(!thaw(entries[index - 1], &error))
+    {
+        emit restoreFailed(error);
+        return std::nullopt;
+    }
+
+    index--;
+    UndoState state = entries[index].state;
+    rebalance();
+    return state;
+}
+
+///
+/// \brief UndoHistory::redo step forward over the next state. Only call if canRedo() is true.
+/// \return the state to reapply, or nothing if its pixel data could not be read back (restoreFailed is emitted and
+///         the position is unchanged)
+///
+std::optional<UndoState> UndoHistory::redo()
+{
+    QString error;
+    if(!thaw(entries[index], &error))
+    {
+        emit restoreFailed(error);
+        return std::nullopt;
+    }
+
+    UndoState state = entries[index].state;
+    index++;
+    rebalance();
+    return state;
+}
+
+///
+/// \brief UndoHistory::setByteBudget set how much memory the history may use before spilling to disk
+/// \param bytes the budget
+///
+void UndoHistory::setByteBudget(qint64 bytes)
+{
+    byteBudget = bytes;
+    rebalance();
+}
+
+///
+/// \brief UndoHistory::getByteBudget
+/// \return how much memory the history may use before spilling to disk
+///
+qint64 UndoHistory::getByteBudget() const
+{
+    return byteBudget;
+}
+
+///
+/// \brief UndoHistory::getMemoryUsage
+/// \return bytes of pixel data currently held in memory, raw or compressed
+///
+qint64 UndoHistory::getMemoryUsage() const
+{
+    qint64 bytes = 0;
+    for(const Entry &entry : entries)
+    {
+        if(entry.tier == Tier::Raw)
+            bytes += entry.rawBytes;
+        else if(entry.tier == Tier::Compressed)
+            bytes += entry.packed.size();
+    }
+    return bytes;
+}
+
+///
+/// \brief UndoHistory::getJournalSize
+/// \return bytes written to the journal on disk
+///
+qint64 UndoHistory::getJournalSize() const
+{
+    return journal.isOpen() ? journal.size() : 0;
+}
+
+///
+/// \brief UndoHistory::isCold
+/// \param position index into entries
+/// \return true if the entry is far enough from the current position to be compressed
+///
+bool UndoHistory::isCold(size_t position) const
+{
+    size_t distance = position < index ? index - 1 - position : position - index;
+    return distance >= (size_t)RAW_WINDOW;
+}
+
+///
+/// \brief UndoHistory::rebalance compress cold entries and spill the oldest ones until within budget
+///
+void UndoHistory::rebalance()
+{
+    for(size_t i = 0; i < entries.size(); i++)
+    {
+        if(entries[i].tier == Tier::Raw && !entries[i].packing && entries[i].rawBytes > 0 && isCold(i))
+            startPacking(entries[i]);
+    }
+
+    qint64 usage = getMemoryUsage();
+    for(size_t i = 0; i < entries.size() && usage > byteBudget; i++)
+    {
+        qint64 packedBytes = entries[i].packed.size();
+        if(entries[i].tier == Tier::Compressed && isCold(i) && spill(entries[i]))
+            usage -= packedBytes;
+    }
+
+    reclaimJournal();
+    emit memoryUsageChanged(usage);
+}
+
+///
+/// \brief UndoHistory::startPacking compress an entry's pixel data on a background thread
+/// \param entry the entry to compress
+///
+void UndoHistory::startPacking(Entry &entry)
+{
+    entry.packing = true;
+    std::vector<QImage> images = payloadOf(entry.state); // implicitly shared, safe to read from another thread
+    quint64 id = entry.id;
+
+    QFutureWatcher<QByteArray> *watcher = new QFutureWatcher<QByteArray>(this);
+    connect(watcher,
+            &QFutureWatcher<QByteArray>::finished,
+            this,
+            [this, watcher, id]
+            {
+                finishPacking(id, watcher->result());
+                watcher->deleteLater();
+            });
+    watcher->setFuture(QtConcurrent::run([images]
+    {
+        return packPayload(images);
+    }));
+}
+
+///
+/// \brief UndoHistory::finishPacking install compressed pixel data, unless the entry was discarded or is needed again
+/// \param id which entry was compressed
+/// \param packed the compressed pixel data
+///
+void UndoHistory::finishPacking(quint64 id, const QByteArray &packed)
+{
+    for(size_t i = 0; i < entries.size(); i++)
+    {
+        Entry &entry = entries[i];
+        if(entry.id != id)
+            continue;
+
+        entry.packing = false;
+        if(entry.tier == Tier::Raw && isCold(i))
+        {
+            entry.packed = packed;
+            entry.tier = Tier::Compressed;
+            dropPayload(entry.state);
+            rebalance();
+        }
+        return;
+    }
+}
+
+///
+/// \brief UndoHistory::spill move a compressed entry's pixel data to the journal on disk. An entry that was spilled
+///        before still has its copy there, since its pixel data never changes, so nothing is written again.
+/// \param entry the entry to spill
+/// \return true if written successfully
+///
+bool UndoHistory::spill(Entry &entry)
+{
+    if(entry.journalOffset < 0)
+    {
+        if(!journal.isOpen() && !journal.open())
+            return false;
+
+        qint64 offset = journal.size();
+        if(!journal.seek(offset) || journal.write(entry.packed) != entry.packed.size())
+            return false;
+
+        entry.journalOffset = offset;
+        entry.journalLength = entry.packed.size();
+    }
+
+    entry.packed = QByteArray();
+    entry.tier = Tier::Spilled;
+    return true;
+}
+
+///
+/// \brief UndoHistory::thaw bring an entry's pixel data back into memory
+/// \param entry the entry to restore
+/// \param error set to a message for the user if it can't be restored
+/// \return true if the entry is Raw now
+///
+bool UndoHistory::thaw(Entry &entry, QString *error)
+{
+    if(entry.tier == Tier::Spilled)
+    {
+        if(!journal.seek(entry.journalOffset))
+        {
+            *error = "The undo history on disk could not be read. " + journal.errorString();
+            return false;
+        }
+        QByteArray packed = journal.read(entry.journalLength);
+        if(packed.size() != entry.journalLength)
+        {
+            *error = "The undo history on disk is incomplete. " + journal.errorString();
+            return false;
+        }
+        entry.packed = std::move(packed);
+        entry.tier = Tier::Compressed;
+    }
+    if(entry.tier == Tier::Compressed)
+    {
+        std::vector<QImage> images = unpackPayload(entry.packed);
+        if(images.size() != 4)
+        {
+            *error = "The undo history is damaged.";
+            return false;
+        }
+        restorePayload(entry.state, images);
+        entry.packed = QByteArray();
+        entry.tier = Tier::Raw;
+    }
+    return true;
+}
+
+///
+/// \brief UndoHistory::reclaimJournal compact the journal once more of it belongs to discarded entries than to the
+///        entries still in the history. The copies that are kept are moved towards the start of the file in place,
+///        so it never needs more disk space than it already has.
+///
+void UndoHistory::reclaimJournal()
+{
+    if(!journal.isOpen())
+        return;
+
+    std::vector<Entry *> kept;
+    qint64 liveBytes = 0;
+    for(Entry &entry : entries)
+    {
+        if(entry.journalOffset < 0)
+            continue;
+        kept.push_back(&entry);
+        liveBytes += entry.journalLength;
+    }
+
+    qint64 deadBytes = journal.size() - liveBytes;
+    if(liveBytes > 0 && (deadBytes <= JOURNAL_SLACK || deadBytes <= liveBytes))
+        return;
+
+    std::sort(kept.begin(),
+              kept.end(),
+              [](const Entry *a, const Entry *b) { return a->journalOffset < b->journalOffset; });
+
+    qint64 end = 0;
+    for(Entry *entry : kept)
+    {
+        if(entry->journalOffset != end)
+        {
+            // the block only ever moves down, so it never overwrites one that hasn't been moved yet
+            if(!journal.seek(entry->journalOffset))
+                return;
+            QByteArray block = journal.read(entry->journalLength);
+            if(block.size() != entry->journalLength || !journal.seek(end) || journal.write(block) != block.size())
+                return;
+            entry->journalOffset = end;
+        }
+        end += entry->journalLength;
+    }
+    journal.resize(end);
+}
+
+///
+/// \brief UndoHistory::payloadOf collect the pixel data held by a state
+/// \param state the state
+/// \return old_pixels, new_pixels, then the canvases of old_frame and new_frame (null images where absent)
+///
+std::vector<QImage> UndoHistory::payloadOf(const UndoState &state)
+{
+    return { state.old_pixels,
+             state.new_pixels,
+             state.old_frame ? state.old_frame->canvas : QImage(),
+             state.new_frame ? state.new_frame->canvas : QImage() };
+}
+
+///
+/// \brief UndoHistory::dropPayload release the pixel data held by a state
+/// \param state the state
+///
+void UndoHistory::dropPayload(UndoState &state)
+{
+    state.old_pixels = QImage();
+    state.new_pixels = QImage();
+    state.old_frame.reset();
+    state.new_frame.reset();
+}
+
+///
+/// \brief UndoHistory::restorePayload give a state back the pixel data collected by payloadOf
+/// \param state the state
+/// \param images pixel data in the order produced by payloadOf
+///
+void UndoHistory::restorePayload(UndoState &state, const std::vector<QImage> &images)
+{
+    if(images.size() != 4)
+        return;
+
+    state.old_pixels = images[0];
+    state.new_pixels = images[1];
+    if(!images[2].isNull())
+        state.old_frame = std::make_shared<Frame>(images[2]);
+    if(!images[3].isNull())
+        state.new_frame = std::make_shared<Frame>(images[3]);
+}
+
+///
+/// \brief UndoHistory::packPayload serialize and compress images. Safe to call from any thread.
+/// \param images images to pack
+/// \return compressed bytes
+///
+QByteArray UndoHistory::packPayload(const std::vector<QImage> &images)
+{
+    QByteArray raw;
+    QDataStream out(&raw, QIODevice::WriteOnly);
+    out << (quint32)images.size();
+    for(const QImage &image : images)
+    {
+        out << (qint32)image.width() << (qint32)image.height() << (qint32)image.format();
+        int rowBytes = (image.width() * image.depth() + 7) / 8;
+        for(int y = 0; y < image.height(); y++)
+            out.writeRawData(reinterpret_cast<const char *>(image.constScanLine(y)), rowBytes);
+    }
+    return qCompress(raw);
+}
+
+///
+/// \brief UndoHistory::unpackPayload reverse packPayload
+/// \param packed compressed bytes
+/// \return the images
+///
+std::vector<QImage> UndoHistory::unpackPayload(const QByteArray &packed)
+{
+    QByteArray raw = qUncompress(packed);
+    QDataStream in(raw);
+    quint32 count = 0;
+    in >> count;
+
+    std::vector<QImage> images;
+    for(quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++)
+    {
+        qint32 width = 0, height = 0, format = 0;
+        in >> width >> height >> format;
+        if(width <= 0 || height <= 0)
+        {
+            images.push_back(QImage());
+            continue;
+        }
+
+        QImage image(width, height, (QImage::Format)format);
+        int rowBytes = (image.width() * image.depth() + 7) / 8;
+        for(int y = 0; y < height; y++)
+            in.readRawData(reinterpret_cast<char *>(image.scanLine(y)), rowBytes);
+        images.push_back(std::move(image));
+    }
+    return images;
+}
@@ -0,0 +1,90 @@
+#ifndef UNDOHISTORY_H
+#define UNDOHISTORY_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QObject>
+#include <QString>
+#include <QTemporaryFile>
+#include "undostate.h"
+#include <optional>
+#include <vector>
+
+///
+/// \brief The UndoHistory class stores UndoStates within a memory budget. The newest states around the
+///        current position are kept as-is, older ones are compressed on a background thread, and once the
+///        budget is exceeded the oldest compressed states are spilled to a temporary journal file.
+///        States are transparently restored when they are undone or redone.
+///
+class UndoHistory : public QObject
+{
+    Q_OBJECT
+
+public:
+    // default limit for the in-memory size of the history
+    static constexpr qint64 DEFAULT_BYTE_BUDGET = 64 * 1024 * 1024;
+
+    // number of states on each side of the current position that are never compressed
+    static constexpr int RAW_WINDOW = 8;
+
+    // bytes of the journal no entry uses any more that are tolerated before it is compacted
+    static constexpr qint64 JOURNAL_SLACK = 16 * 1024 * 1024;
+
+    explicit UndoHistory(QObject *parent = nullptr);
+
+    void push(UndoState state);
+    void clear();
+
+    bool canUndo() const;
+    bool canRedo() const;
+    std::optional<UndoState> undo();
+    std::optional<UndoState> redo();
+
+    void setByteBudget(qint64 bytes);
+    qint64 getByteBudget() const;
+    qint64 getMemoryUsage() const;
+    qint64 getJournalSize() const;
+
+signals:
+    void memoryUsageChanged(qint64 bytes);
+    void restoreFailed(const QString &error);
+
+private:
+    enum class Tier { Raw, Compressed, Spilled };
+
+    struct Entry
+    {
+        Entry(quint64 _id, UndoState _state);
+
+        quint64 id;
+        UndoState state;           // pixel data is dropped while the entry is not Raw
+        Tier tier = Tier::Raw;
+        qint64 rawBytes = 0;       // size of the uncompressed pixel data
+        QByteArray packed;         // compressed pixel data while Compressed
+        qint64 journalOffset = -1; // location of the compressed pixel data once Spilled; kept after it is thawed
+        qint64 journalLength = 0;
+        bool packing = false;      // a background compression job is running
+    };
+
+    std::vector<Entry> entries;
+    size_t index = 0;
+    quint64 nextId = 0;
+    qint64 byteBudget = DEFAULT_BYTE_BUDGET;
+    QTemporaryFile journal;
+
+    bool isCold(size_t position) const;
+    void rebalance();
+    void startPacking(Entry &entry);
+    void finishPacking(quint64 id, const QByteArray &packed);
+    bool spill(Entry &entry);
+    bool thaw(Entry &entry, QString *error);
+    void reclaimJournal();
+
+    static std::vector<QImage> payloadOf(const UndoState &state);
+    static void dropPayload(UndoState &state);
+    static void restorePayload(UndoState &state, const std::vector<QImage> &images);
+    static QByteArray packPayload(const std::vector<QImage> &images);
+    static std::vector<QImage> unpackPayload(const QByteArray &packed);
+};
+
+#endif // UNDOHISTORY_H
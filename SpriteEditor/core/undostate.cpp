@@ -69,3 +69,21 @@ UndoState UndoState::forFrameReinsert(int from_index, int to_index, std::shared_
     s.new_frame = frame;
     return s;
 }
+
+///
+/// \brief UndoState::forRegionChange static helper to construct an UndoState representing a change to part of a frame's canvas
+/// \param index which frame?
+/// \param region area of the canvas that changed
+/// \param old_pixels pixels inside region before the change
+/// \param new_pixels pixels inside region after the change
+/// \return UndoState
+///
+UndoState UndoState::forRegionChange(int index, const QRect &region, const QImage &old_pixels, const QImage &new_pixels)
+{
+    UndoState s(UndoStateType::REGION_CHANGE);
+    s.frame_start_index = index;
+    s.region = region;
+    s.old_pixels = old_pixels;
+    s.new_pixels = new_pixels;
+    return s;
+}
@@ -4,6 +4,8 @@
 #include "frame.h"
 #include <functional>
 #include <memory>
+#include <QImage>
+#include <QRect>
 
 ///
 /// \brief The UndoStateType enum represents the type of change held in an UndoState.
@@ -20,7 +22,10 @@ enum class UndoStateType
     FRAME_DELETE,
 
     // A frame has been removed from frame_start_index and subsequently inserted at frame_end_index, with data unchanged in new_frame
-    FRAME_REINSERT
+    FRAME_REINSERT,
+
+    // The pixels inside region of the frame at frame_start_index have changed (previously old_pixels, now new_pixels)
+    REGION_CHANGE
 };
 
 ///
@@ -36,12 +41,16 @@ public:
     static UndoState forFrameAdd(int index, std::shared_ptr<Frame> frame);
     static UndoState forFrameDelete(int index, std::shared_ptr<Frame> deleted_frame);
     static UndoState forFrameReinsert(int from_index, int to_index, std::shared_ptr<Frame> frame);
+    static UndoState forRegionChange(int index, const QRect &region, const QImage &old_pixels, const QImage &new_pixels);
 
     UndoStateType type;
     int frame_start_index = -1;
     int frame_end_index = -1;
     std::shared_ptr<Frame> old_frame;
     std::shared_ptr<Frame> new_frame;
+    QRect region;
+    QImage old_pixels;
+    QImage new_pixels;
 };
 
 #endif // UNDOSTATE_H
@@ -0,0 +1,158 @@
+#include "animationtest.h"
+#include "animation.h"
+#include <QAbstractItemModelTester>
+#include <QMimeData>
+#include <QSignalSpy>
+#include <QtTest>
+
+///
+/// \brief AnimationTest::modelTester run QAbstractItemModelTester over every change the editor makes to the frames;
+///        it fails the test as soon as a notification doesn't match what the model reports
+///
+void AnimationTest::modelTester()
+{
+    Animation animation(nullptr, QSize(16, 16));
+    QAbstractItemModelTester tester(&animation, QAbstractItemModelTester::FailureReportingMode::QtTest);
+
+    animation.addFrame(animation.getFrameSize());
+    animation.addFrame(animation.getFrameSize());
+    animation.insertFrame(1, std::make_shared<Frame>(16, 16));
+    animation.insertFrame(0, std::make_shared<Frame>(16, 16));
+    animation.copyFrame(2);
+    animation.copyFrame(animation.rowCount() - 1);
+    QCOMPARE(animation.rowCount(), 7);
+
+    animation.deleteFrame(0);
+    animation.deleteFrame(animation.rowCount() - 1);
+    animation.deleteFrame(2);
+    QCOMPARE(animation.rowCount(), 4);
+
+    animation.replaceFrame(1, std::make_shared<Frame>(16, 16));
+    QImage pixels(4, 4, QImage::Format_ARGB32);
+    pixels.fill(Qt::red);
+    animation.patchFrame(2, QRect(2, 2, 4, 4), pixels);
+
+    QVERIFY(animation.moveRows(QModelIndex(), 0, 1, QModelIndex(), 3));
+    QVERIFY(animation.moveRows(QModelIndex(), 3, 1, QModelIndex(), 1));
+    QVERIFY(!animation.moveRows(QModelIndex(), 2, 1, QModelIndex(), 2));
+    QVERIFY(!animation.moveRows(QModelIndex(), 0, 1, QModelIndex(), animation.rowCount()));
+
+    // dragging a frame in the list view goes through the mime data
+    std::unique_ptr<QMimeData> dragged(animation.mimeData({ animation.index(0, 0) }));
+    QVERIFY(animation.dropMimeData(dragged.get(), Qt::MoveAction, 2, 0, QModelIndex()));
+
+    AnimationSnapshot snapshot;
+    snapshot.frameSize = QSize(8, 8);
+    for(int i = 0; i < 3; i++)
+    {
+        QImage image(8, 8, QImage::Format_ARGB32);
+        image.fill(Qt::transparent);
+        snapshot.frames.push_back(image);
+    }
+    animation.restore(snapshot);
+    QCOMPARE(animation.rowCount(), 3);
+
+    animation.restoreLazily(QSize(8, 8), 5, [](int)
+    {
+        QImage image(8, 8, QImage::Format_ARGB32);
+        image.fill(Qt::transparent);
+        return image;
+    });
+    QCOMPARE(animation.rowCount(), 5);
+
+    // the last frame can't be deleted
+    while(animation.rowCount() > 1)
+        animation.deleteFrame(0);
+    animation.deleteFrame(0);
+    QCOMPARE(animation.rowCount(), 1);
+}
+
+///
+/// \brief AnimationTest::rowNotifications adding, copying and deleting a frame notify only the row involved,
+///        never by resetting the model
+///
+void AnimationTest::rowNotifications()
+{
+    Animation animation(nullptr, QSize(16, 16));
+    QSignalSpy resets(&animation, &QAbstractItemModel::modelReset);
+    QSignalSpy inserted(&animation, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removed(&animation, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy changed(&animation, &QAbstractItemModel::dataChanged);
+
+    animation.addFrame(animation.getFrameSize());
+    QCOMPARE(inserted.count(), 1);
+    QCOMPARE(inserted.last().at(1).toInt(), 1);
+    QCOMPARE(inserted.last().at(2).toInt(), 1);
+
+    animation.copyFrame(0);
+    QCOMPARE(inserted.count(), 2);
+    QCOMPARE(inserted.last().at(1).toInt(), 1);
+
+    animation.deleteFrame(2);
+    QCOMPARE(removed.count(), 1);
+    QCOMPARE(removed.last().at(1).toInt(), 2);
+    QCOMPARE(removed.last().at(2).toInt(), 2);
+
+    animation.replaceFrame(1, std::make_shared<Frame>(16, 16));
+    QCOMPARE(changed.count(), 1);
+    QCOMPARE(changed.last().at(0).toModelIndex().row(), 1);
+    QCOMPARE(changed.last().at(1).toModelIndex().row(), 1);
+
+    QCOMPARE(resets.count(), 0);
+}
+
+///
+/// \brief AnimationTest::moveRows moving a frame up or down puts it where it was dropped and keeps the others in order
+///
+void AnimationTest::moveRows()
+{
+    Animation animation(nullptr, QSize(4, 4));
+    for(int i = 0; i < 3; i++)
+        animation.addFrame(animation.getFrameSize());
+
+    std::vector<std::shared_ptr<Frame>> before;
+    for(int i = 0; i < animation.rowCount(); i++)
+        before.push_back(animation.getFrame(i));
+
+    QVERIFY(animation.moveRows(QModelIndex(), 0, 1, QModelIndex(), 2));
+    QCOMPARE(animation.getFrame(0).get(), before[1].get());
+    QCOMPARE(animation.getFrame(1).get(), before[2].get());
+    QCOMPARE(animation.getFrame(2).get(), before[0].get());
+    QCOMPARE(animation.getFrame(3).get(), before[3].get());
+    QCOMPARE(animation.getCurrFrameIndex(), 2);
+
+    QVERIFY(animation.moveRows(QModelIndex(), 3, 1, QModelIndex(), 0));
+    QCOMPARE(animation.getFrame(0).get(), before[3].get());
+    QCOMPARE(animation.getFrame(1).get(), before[1].get());
+    QCOMPARE(animation.getFrame(2).get(), before[2].get());
+    QCOMPARE(animation.getFrame(3).get(), before[0].get());
+}
+
+///
+/// \brief AnimationTest::insertDeleteFrames_data frame counts to time
+///
+void AnimationTest::insertDeleteFrames_data()
+{
+    QTest::addColumn<int>("frameCount");
+    QTest::newRow("500") << 500;
+    QTest::newRow("5000") << 5000;
+}
+
+///
+/// \brief AnimationTest::insertDeleteFrames time adding frameCount frames one at a time, then deleting them from
+///        the middle of the list; each one is a single row notification
+///
+void AnimationTest::insertDeleteFrames()
+{
+    QFETCH(int, frameCount);
+    Animation animation(nullptr, QSize(32, 32));
+
+    QBENCHMARK
+    {
+        for(int i = 0; i < frameCount; i++)
+            animation.addFrame(animation.getFrameSize(), false);
+        while(animation.rowCount() > 1)
+            animation.deleteFrame(animation.rowCount() / 2, false);
+    }
+    QCOMPARE(animation.rowCount(), 1);
+}
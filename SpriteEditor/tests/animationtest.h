@@ -0,0 +1,22 @@
+#ifndef ANIMATIONTEST_H
+#define ANIMATIONTEST_H
+
+#include <QObject>
+
+///
+/// \brief The AnimationTest class checks that Animation is a well-behaved item model through every way the
+///        editor changes its frames, and times inserting and deleting many frames.
+///
+class AnimationTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void modelTester();
+    void rowNotifications();
+    void moveRows();
+    void insertDeleteFrames_data();
+    void insertDeleteFrames();
+};
+
+#endif // ANIMATIONTEST_H
@@ -0,0 +1,309 @@
+#include "kernelstest.h"
+#include <algorithm>
+#include "ditherpattern.h"
+#include "pixelkernels.h"
+#include <QPainter>
+#include <QRandomGenerator>
+#include <QtTest>
+#include "stencil.h"
+#include "toolkernels.h"
+#include <vector>
+
+Q_DECLARE_METATYPE(BlendMode)
+
+// longest row the kernels are compared on; every length up to it is tried, so each vector width gets odd tails
+static const int MAX_ROW_LENGTH = 67;
+// pixels past the end of each row that no kernel may touch
+static const int GUARD_LENGTH = 9;
+static const QRgb GUARD_PIXEL = 0xDEADBEEF;
+
+///
+/// \brief Row is one row of pixels and a mask, with guard pixels after it
+///
+struct Row
+{
+    std::vector<QRgb> pixels;
+    std::vector<QRgb> source;
+    std::vector<uchar> mask;
+};
+
+///
+/// \brief randomRow
+/// \param random generator to fill the row from; two rows made from generators with the same seed are the same
+/// \param offset pixels before the row starts, so the kernels also see rows that aren't 16 or 32 byte aligned
+/// \param count length of the row
+/// \return the row
+///
+static Row randomRow(QRandomGenerator &random, int offset, int count)
+{
+    Row row;
+    int length = offset + count + GUARD_LENGTH;
+    row.pixels.resize(length);
+    row.source.resize(length);
+    row.mask.resize(length);
+    for (int i = 0; i < length; i++)
+    {
+        row.pixels[i] = random.generate();
+        row.source[i] = random.generate();
+        // mostly runs of zeros with some set bytes, so both the skip and the blend paths are taken
+        row.mask[i] = random.bounded(3) == 0 ? (uchar)random.bounded(1, 256) : 0;
+    }
+    std::fill(row.pixels.begin() + offset + count, row.pixels.end(), GUARD_PIXEL);
+    return row;
+}
+
+///
+/// \brief runKernel run one row kernel, by name, on a row
+/// \param kernel name of the PixelKernels function
+/// \param row row to write
+/// \param offset where the row starts
+/// \param count length of the row
+///
+static void runKernel(const QByteArray &kernel, Row &row, int offset, int count)
+{
+    QRgb *dst = row.pixels.data() + offset;
+    const QRgb *src = row.source.data() + offset;
+    const uchar *mask = row.mask.data() + offset;
+    if (kernel == "fillRowMasked")
+        PixelKernels::fillRowMasked(dst, mask, count, 0xFF112233);
+    else if (kernel == "eraseRowMasked")
+        PixelKernels::eraseRowMasked(dst, mask, count);
+    else if (kernel == "copyRowMasked")
+        PixelKernels::copyRowMasked(dst, src, mask, count);
+}
+
+///
+/// \brief baselineLineStencil the stencil the tools used before Stencil: a black line on a white image the size of
+///        the whole canvas, drawn once for every pixel of the tool's square
+/// \param canvas the canvas the line is for
+/// \param lineSize the tool's size
+/// \param from one end of the line
+/// \param to the other end
+/// \return the stencil
+///
+static QImage baselineLineStencil(const QImage &canvas, int lineSize, QPoint from, QPoint to)
+{
+    QImage stencil(canvas.size(), QImage::Format_RGB32);
+    stencil.fill(Qt::white);
+    QPainter painter(&stencil);
+    painter.setPen(Qt::black);
+    for (int i = 0; i < lineSize; i++)
+    {
+        for (int j = 0; j < lineSize; j++)
+        {
+            painter.drawLine(from.x() + i, from.y() + j, to.x() + i, to.y() + j);
+        }
+    }
+    painter.end();
+    return stencil;
+}
+
+///
+/// \brief KernelsTest::cleanup go back to the fastest kernels after each test
+///
+void KernelsTest::cleanup()
+{
+    PixelKernels::useInstructionSet(PixelKernels::supportedInstructionSets().front());
+}
+
+///
+/// \brief KernelsTest::rowKernels_data every vector instruction set this CPU has, with every kernel
+///
+void KernelsTest::rowKernels_data()
+{
+    QTest::addColumn<QByteArray>("instructionSet");
+    QTest::addColumn<QByteArray>("kernel");
+
+    for (const char *instructionSet : PixelKernels::supportedInstructionSets())
+    {
+        if (qstrcmp(instructionSet, "scalar") == 0)
+            continue;
+        for (const char *kernel : { "fillRowMasked", "eraseRowMasked", "copyRowMasked", "rowsEqual" })
+        {
+            QTest::addRow("%s %s", instructionSet, kernel) << QByteArray(instructionSet) << QByteArray(kernel);
+        }
+    }
+    if (PixelKernels::supportedInstructionSets().size() == 1)
+        QTest::newRow("scalar only") << QByteArray() << QByteArray();
+}
+
+///
+/// \brief KernelsTest::rowKernels a vector kernel writes the same pixels as the scalar one, and nothing past the
+///        end of the row, at every length up to MAX_ROW_LENGTH and at every alignment
+///
+void KernelsTest::rowKernels()
+{
+    QFETCH(QByteArray, instructionSet);
+    QFETCH(QByteArray, kernel);
+    if (instructionSet.isEmpty())
+        QSKIP("This CPU has no vector kernels to compare.");
+
+    for (int offset = 0; offset < 8; offset++)
+    {
+        for (int count = 0; count <= MAX_ROW_LENGTH; count++)
+        {
+            quint32 seed = offset * 1000 + count;
+            QRandomGenerator scalarRandom(seed);
+            QRandomGenerator vectorRandom(seed);
+            Row expected = randomRow(scalarRandom, offset, count);
+            Row actual = randomRow(vectorRandom, offset, count);
+
+            if (kernel == "rowsEqual")
+            {
+                // equal rows, then rows that differ in one pixel, at each position in turn
+                std::copy(expected.pixels.begin(), expected.pixels.end(), expected.source.begin());
+                const QRgb *a = expected.pixels.data() + offset;
+                QVERIFY(PixelKernels::useInstructionSet(instructionSet.constData()));
+                QVERIFY2(PixelKernels::rowsEqual(a, expected.source.data() + offset, count),
+                         qPrintable(QString("equal rows of %1 at offset %2").arg(count).arg(offset)));
+                for (int i = 0; i < count; i++)
+                {
+                    expected.source[offset + i] ^= 1;
+                    QVERIFY2(!PixelKernels::rowsEqual(a, expected.source.data() + offset, count),
+                             qPrintable(QString("pixel %1 of %2 at offset %3").arg(i).arg(count).arg(offset)));
+                    expected.source[offset + i] ^= 1;
+                }
+                continue;
+            }
+
+            QVERIFY(PixelKernels::useInstructionSet("scalar"));
+            runKernel(kernel, expected, offset, count);
+            QVERIFY(PixelKernels::useInstructionSet(instructionSet.constData()));
+            runKernel(kernel, actual, offset, count);
+
+            QVERIFY2(actual.pixels == expected.pixels,
+                     qPrintable(QString("row of %1 at offset %2").arg(count).arg(offset)));
+        }
+    }
+}
+
+///
+/// \brief KernelsTest::applyStencil_data every blend mode, with a solid and a dithered pattern, on each instruction set
+///
+void KernelsTest::applyStencil_data()
+{
+    QTest::addColumn<QByteArray>("instructionSet");
+    QTest::addColumn<BlendMode>("blend");
+    QTest::addColumn<bool>("dither");
+
+    const std::pair<const char *, BlendMode> blends[] = {
+        { "replace", BlendMode::Replace }, { "erase", BlendMode::Erase }
+    };
+    for (const char *instructionSet : PixelKernels::supportedInstructionSets())
+    {
+        for (const auto &blend : blends)
+        {
+            QTest::addRow("%s %s solid", instructionSet, blend.first) << QByteArray(instructionSet) << blend.second << false;
+            QTest::addRow("%s %s dither", instructionSet, blend.first) << QByteArray(instructionSet) << blend.second << true;
+        }
+    }
+}
+
+///
+/// \brief KernelsTest::applyStencil applyStencil writes what setting the stencil's pixels one at a time does
+///
+void KernelsTest::applyStencil()
+{
+    QFETCH(QByteArray, instructionSet);
+    QFETCH(BlendMode, blend);
+    QFETCH(bool, dither);
+    QVERIFY(PixelKernels::useInstructionSet(instructionSet.constData()));
+
+    // a translucent color is written as it is, not composited over the canvas
+    DitherPattern pattern = dither ? DitherPattern(DitherPattern::Type::Bayer4x4, 40, 0x80204080, 0xFFC0A060)
+                                   : DitherPattern(0x80204080);
+    QImage canvas(61, 43, QImage::Format_ARGB32);
+    canvas.fill(0x80FFFFFF);
+    Stencil stencil = Stencil::forPolyline(canvas.rect(), 5, QPolygon({ QPoint(-3, 2), QPoint(40, 37), QPoint(58, 5) }));
+
+    QImage expected = canvas.copy();
+    QRect bounds = stencil.getBounds();
+    for (int y = bounds.top(); y <= bounds.bottom(); y++)
+    {
+        for (int x = bounds.left(); x <= bounds.right(); x++)
+        {
+            if (stencil.contains(x, y))
+                expected.setPixel(x, y, blend == BlendMode::Erase ? 0 : pattern.colorAt(x, y));
+        }
+    }
+
+    ToolKernels::applyStencil(canvas, stencil, blend, pattern);
+    QCOMPARE(canvas, expected);
+}
+
+///
+/// \brief KernelsTest::applyStencilBenchmark_data every blend and pattern mode at small and large brush sizes, and
+///        the per-pixel loop the tools used before the kernels
+///
+void KernelsTest::applyStencilBenchmark_data()
+{
+    QTest::addColumn<BlendMode>("blend");
+    QTest::addColumn<bool>("dither");
+    QTest::addColumn<int>("toolSize");
+    QTest::addColumn<bool>("perPixel");
+
+    const std::pair<const char *, BlendMode> blends[] = {
+        { "replace", BlendMode::Replace }, { "erase", BlendMode::Erase }
+    };
+    for (int toolSize : { 4, 32, 128 })
+    {
+        for (const auto &blend : blends)
+        {
+            for (bool dither : { false, true })
+            {
+                // erasing doesn't read the pattern
+                if (blend.second == BlendMode::Erase && dither)
+                    continue;
+                const char *patternName = dither ? "dither" : "solid";
+                QTest::addRow("%s %s %d", blend.first, patternName, toolSize) << blend.second << dither << toolSize << false;
+                QTest::addRow("%s %s %d per-pixel", blend.first, patternName, toolSize) << blend.second << dither << toolSize << true;
+            }
+        }
+    }
+}
+
+///
+/// \brief KernelsTest::applyStencilBenchmark time writing a long brush stroke onto a large canvas, building the
+///        stencil included
+///
+void KernelsTest::applyStencilBenchmark()
+{
+    QFETCH(BlendMode, blend);
+    QFETCH(bool, dither);
+    QFETCH(int, toolSize);
+    QFETCH(bool, perPixel);
+
+    DitherPattern pattern = dither ? DitherPattern(DitherPattern::Type::Bayer8x8, 50, 0xC0204080, 0xFFC0A060)
+                                   : DitherPattern(0xC0204080);
+    QImage canvas(1024, 1024, QImage::Format_ARGB32);
+    canvas.fill(0x80FFFFFF);
+    QPolygon points({ QPoint(10, 10), QPoint(1000, 400), QPoint(50, 1000) });
+
+    if (perPixel)
+    {
+        // as the tools did before Stencil and the kernels: a QPainter stencil per segment, then a color per pixel
+        QBENCHMARK
+        {
+            for (int i = 1; i < points.size(); i++)
+            {
+                QImage lineStencil = baselineLineStencil(canvas, toolSize, points[i - 1], points[i]);
+                for (int x = 0; x < lineStencil.width(); x++)
+                {
+                    for (int y = 0; y < lineStencil.height(); y++)
+                    {
+                        if (lineStencil.pixelColor(x, y) == Qt::black)
+                            canvas.setPixelColor(x, y, blend == BlendMode::Erase ? QColor(Qt::transparent)
+                                                                                 : QColor::fromRgba(pattern.colorAt(x, y)));
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    QBENCHMARK
+    {
+        Stencil stencil = Stencil::forPolyline(canvas.rect(), toolSize, points);
+        ToolKernels::applyStencil(canvas, stencil, blend, pattern);
+    }
+}
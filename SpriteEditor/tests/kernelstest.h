@@ -0,0 +1,27 @@
+#ifndef KERNELSTEST_H
+#define KERNELSTEST_H
+
+#include <QObject>
+
+///
+/// \brief The KernelsTest class checks the SSE2 and AVX2 row kernels against the scalar ones, and ToolKernels
+///        against writing the same stencil a pixel at a time; it also times a stroke for every blend and pattern
+///        mode next to the QPainter stencil and per-pixel loop the tools used before.
+///
+class KernelsTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cleanup();
+
+    void rowKernels_data();
+    void rowKernels();
+    void applyStencil_data();
+    void applyStencil();
+
+    void applyStencilBenchmark_data();
+    void applyStencilBenchmark();
+};
+
+#endif // KERNELSTEST_H
@@ -0,0 +1,25 @@
+#include "animationtest.h"
+#include "kernelstest.h"
+#include "spritefiletest.h"
+#include <QCoreApplication>
+#include <QtTest>
+
+///
+/// \brief main run every test class; the core library needs no display, so neither do the tests
+/// \param argc number of arguments
+/// \param argv arguments passed on to QTest::qExec
+/// \return 0 if every test passed
+///
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int failures = 0;
+    AnimationTest animationTest;
+    failures += QTest::qExec(&animationTest, argc, argv);
+    KernelsTest kernelsTest;
+    failures += QTest::qExec(&kernelsTest, argc, argv);
+    SpriteFileTest spriteFileTest;
+    failures += QTest::qExec(&spriteFileTest, argc, argv);
+    return failures;
+}
@@ -0,0 +1,487 @@
+#include "spritefiletest.h"
+#include <algorithm>
+#include "legacyspritefile.h"
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryFile>
+#include <QtEndian>
+#include <QtTest>
+#include "spritefile.h"
+#include "spritefilereader.h"
+
+// where the header keeps the frame table's offset
+static const qint64 INDEX_OFFSET_POSITION = 20;
+
+///
+/// \brief makeSnapshot a small square moving across a translucent gradient, so that each frame differs from the one
+///        before it in a small rectangle and write() stores most frames as deltas
+/// \param frameCount number of frames
+/// \param size size of every frame
+/// \return the animation, with a distinct revision for each frame
+///
+static AnimationSnapshot makeSnapshot(int frameCount, const QSize &size)
+{
+    QImage background(size, QImage::Format_ARGB32);
+    for (int y = 0; y < size.height(); y++)
+    {
+        for (int x = 0; x < size.width(); x++)
+        {
+            background.setPixel(x, y, qRgba(x * 7 & 255, y * 13 & 255, (x + y) * 3 & 255, 255 - (x * y & 127)));
+        }
+    }
+
+    AnimationSnapshot snapshot;
+    snapshot.frameSize = size;
+    for (int i = 0; i < frameCount; i++)
+    {
+        QImage frame = background.copy();
+        for (int y = 0; y < 3; y++)
+        {
+            for (int x = 0; x < 3; x++)
+            {
+                frame.setPixel((i + x) % size.width(), (i + y) % size.height(), qRgba(255, 0, i * 20 & 255, 128));
+            }
+        }
+        snapshot.frames.push_back(frame);
+        snapshot.revisions.push_back(i + 1);
+    }
+    return snapshot;
+}
+
+///
+/// \brief compareFrames check that frames read back are the ones written
+/// \param actual the frames read
+/// \param expected the frames written, at the size they should read back at
+///
+static void compareFrames(const std::vector<QImage> &actual, const std::vector<QImage> &expected)
+{
+    QCOMPARE(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); i++)
+    {
+        QVERIFY2(actual[i].convertToFormat(QImage::Format_ARGB32) == expected[i].convertToFormat(QImage::Format_ARGB32),
+                 qPrintable(QString("frame %1 differs").arg(i)));
+    }
+}
+
+///
+/// \brief compareReader check that a reader decodes every frame as written, in order and then backwards, so both
+///        the recently decoded blocks and following deltas back to a whole frame are used
+/// \param filename file to open
+/// \param expected the frames written
+///
+static void compareReader(const QString &filename, const std::vector<QImage> &expected)
+{
+    QString error;
+    std::shared_ptr<SpriteFileReader> reader = SpriteFileReader::open(filename, &error);
+    QVERIFY2(reader, qPrintable(error));
+    QCOMPARE(reader->getFrameCount(), (int)expected.size());
+
+    std::vector<QImage> forwards;
+    for (int i = 0; i < reader->getFrameCount(); i++)
+    {
+        forwards.push_back(reader->decodeFrame(i));
+    }
+    compareFrames(forwards, expected);
+
+    std::shared_ptr<SpriteFileReader> fresh = SpriteFileReader::open(filename, &error);
+    QVERIFY2(fresh, qPrintable(error));
+    std::vector<QImage> backwards(expected.size());
+    for (int i = fresh->getFrameCount() - 1; i >= 0; i--)
+    {
+        backwards[i] = fresh->decodeFrame(i);
+    }
+    compareFrames(backwards, expected);
+}
+
+///
+/// \brief readTable read a file's header and frame table
+/// \param filename the file
+/// \param header set to the header
+/// \return the table, or nothing if it couldn't be read
+///
+static std::vector<SpriteFile::FrameEntry> readTable(const QString &filename, SpriteFile::Header &header)
+{
+    std::vector<SpriteFile::FrameEntry> entries;
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly) || !SpriteFile::parseHeader(file.read(SpriteFile::HEADER_SIZE), header, nullptr)
+        || !file.seek(header.indexOffset))
+    {
+        return entries;
+    }
+    SpriteFile::parseTable(file.read((qint64)header.frameCount * SpriteFile::ENTRY_SIZE), header.frameCount, file.size(),
+                           entries, nullptr);
+    return entries;
+}
+
+///
+/// \brief patchFile overwrite bytes in a file
+/// \param filename the file
+/// \param position where to start
+/// \param bytes what to write there
+///
+static void patchFile(const QString &filename, qint64 position, const QByteArray &bytes)
+{
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.seek(position));
+    QCOMPARE(file.write(bytes), (qint64)bytes.size());
+}
+
+///
+/// \brief littleEndian
+/// \param value a number
+/// \param size how many bytes to store it in
+/// \return the number as it is stored in a file
+///
+static QByteArray littleEndian(quint64 value, int size)
+{
+    QByteArray bytes(8, '\0');
+    qToLittleEndian<quint64>(value, bytes.data());
+    return bytes.left(size);
+}
+
+///
+/// \brief writeFile write a snapshot to a temporary file
+/// \param file the file; opened, written and closed
+/// \param snapshot the animation
+/// \param keyframeInterval see SpriteFile::write
+/// \param layout set to what the file holds
+///
+static void writeFile(QTemporaryFile &file, const AnimationSnapshot &snapshot, int keyframeInterval,
+                      SpriteFile::Layout *layout = nullptr)
+{
+    QVERIFY(file.open());
+    QString error;
+    QVERIFY2(SpriteFile::write(&file, snapshot, &error, layout, keyframeInterval), qPrintable(error));
+    file.close();
+}
+
+///
+/// \brief SpriteFileTest::roundTrip_data every frame stored whole, and chains of deltas, also from frames of other
+///        sizes than the animation's
+///
+void SpriteFileTest::roundTrip_data()
+{
+    QTest::addColumn<int>("keyframeInterval");
+    QTest::addColumn<bool>("mixedSizes");
+
+    QTest::newRow("every frame whole") << 1 << false;
+    QTest::newRow("deltas") << SpriteFile::KEYFRAME_INTERVAL << false;
+    QTest::newRow("deltas, mixed sizes") << SpriteFile::KEYFRAME_INTERVAL << true;
+}
+
+///
+/// \brief SpriteFileTest::roundTrip write() then read(), and every frame through SpriteFileReader, give back the
+///        frames written, fitted to the animation's size
+///
+void SpriteFileTest::roundTrip()
+{
+    QFETCH(int, keyframeInterval);
+    QFETCH(bool, mixedSizes);
+
+    AnimationSnapshot snapshot = makeSnapshot(40, QSize(24, 16));
+    if (mixedSizes)
+    {
+        // frames pasted in at another size keep it until the file is written
+        snapshot.frames[3] = snapshot.frames[3].copy(0, 0, 20, 18);
+        snapshot.frames[4] = snapshot.frames[4].scaled(30, 10);
+    }
+    std::vector<QImage> expected;
+    for (const QImage &frame : snapshot.frames)
+    {
+        expected.push_back(SpriteFile::fitToSize(frame, snapshot.frameSize));
+    }
+
+    QTemporaryFile file;
+    writeFile(file, snapshot, keyframeInterval);
+    if (QTest::currentTestFailed())
+        return;
+
+    SpriteFile::Header header;
+    std::vector<SpriteFile::FrameEntry> entries = readTable(file.fileName(), header);
+    QCOMPARE(entries.size(), snapshot.frames.size());
+    int deltas = std::count_if(entries.begin(), entries.end(), [](const SpriteFile::FrameEntry &entry)
+    {
+        return entry.encoding == SpriteFile::Encoding::Delta;
+    });
+    if (keyframeInterval == 1)
+        QCOMPARE(deltas, 0);
+    else
+        QVERIFY(deltas > 0);
+
+    QVERIFY(file.open());
+    AnimationSnapshot loaded;
+    QString error;
+    QVERIFY2(SpriteFile::read(&file, loaded, &error), qPrintable(error));
+    file.close();
+    QCOMPARE(loaded.frameSize, snapshot.frameSize);
+    compareFrames(loaded.frames, expected);
+    if (QTest::currentTestFailed())
+        return;
+
+    compareReader(file.fileName(), expected);
+}
+
+///
+/// \brief SpriteFileTest::appendEditedFrame saving after editing one frame only adds that frame to the file, which
+///        then reads back with the edit; a layout that no longer matches the file is refused without touching it
+///
+void SpriteFileTest::appendEditedFrame()
+{
+    AnimationSnapshot snapshot = makeSnapshot(40, QSize(24, 16));
+    QTemporaryFile file;
+    SpriteFile::Layout layout;
+    writeFile(file, snapshot, SpriteFile::KEYFRAME_INTERVAL, &layout);
+    if (QTest::currentTestFailed())
+        return;
+    SpriteFile::Layout written = layout;
+    qint64 writtenSize = file.size();
+
+    // as Model saves: the frames the file already holds are left out
+    QImage edited = snapshot.frames[5].copy();
+    edited.fill(qRgba(10, 200, 30, 90));
+    std::vector<QImage> expected = snapshot.frames;
+    expected[5] = edited;
+    AnimationSnapshot changes = snapshot;
+    for (QImage &frame : changes.frames)
+    {
+        frame = QImage();
+    }
+    changes.frames[5] = edited;
+    changes.revisions[5] = 1000;
+
+    QFile appended(file.fileName());
+    QVERIFY(appended.open(QIODevice::ReadWrite));
+    QString error;
+    QVERIFY2(SpriteFile::append(&appended, changes, layout, &error), qPrintable(error));
+    appended.close();
+    QVERIFY(file.size() > writtenSize);
+    QVERIFY(file.size() - writtenSize < writtenSize / 4);
+    QCOMPARE(layout.fileSize, (quint64)file.size());
+    QCOMPARE(layout.generation, written.generation + 1);
+
+    QVERIFY(file.open());
+    AnimationSnapshot loaded;
+    QVERIFY2(SpriteFile::read(&file, loaded, &error), qPrintable(error));
+    file.close();
+    compareFrames(loaded.frames, expected);
+    if (QTest::currentTestFailed())
+        return;
+    compareReader(file.fileName(), expected);
+    if (QTest::currentTestFailed())
+        return;
+
+    // the layout from before the append describes a file that isn't there any more
+    qint64 appendedSize = file.size();
+    QVERIFY(appended.open(QIODevice::ReadWrite));
+    QVERIFY(!SpriteFile::append(&appended, changes, written, &error));
+    appended.close();
+    QCOMPARE(file.size(), appendedSize);
+}
+
+///
+/// \brief SpriteFileTest::damagedTable_data ways the frame table can be cut off or point outside the file
+///
+void SpriteFileTest::damagedTable_data()
+{
+    QTest::addColumn<QString>("damage");
+
+    QTest::newRow("truncated table") << "truncated table";
+    QTest::newRow("table past the end") << "table past the end";
+    QTest::newRow("block past the end") << "block past the end";
+    QTest::newRow("unknown encoding") << "unknown encoding";
+}
+
+///
+/// \brief SpriteFileTest::damagedTable neither read() nor SpriteFileReader accepts a damaged table
+///
+void SpriteFileTest::damagedTable()
+{
+    QFETCH(QString, damage);
+
+    QTemporaryFile file;
+    writeFile(file, makeSnapshot(8, QSize(24, 16)), SpriteFile::KEYFRAME_INTERVAL);
+    if (QTest::currentTestFailed())
+        return;
+    SpriteFile::Header header;
+    std::vector<SpriteFile::FrameEntry> entries = readTable(file.fileName(), header);
+    QCOMPARE(entries.size(), (size_t)8);
+
+    if (damage == "truncated table")
+        QVERIFY(QFile::resize(file.fileName(), file.size() - SpriteFile::ENTRY_SIZE / 2));
+    else if (damage == "table past the end")
+        patchFile(file.fileName(), INDEX_OFFSET_POSITION, littleEndian(file.size(), 8));
+    else if (damage == "block past the end")
+        patchFile(file.fileName(), header.indexOffset + 8, littleEndian(0xFFFFFFF0, 4));
+    else if (damage == "unknown encoding")
+        patchFile(file.fileName(), header.indexOffset + 12, littleEndian(7, 1));
+    if (QTest::currentTestFailed())
+        return;
+
+    QVERIFY(file.open());
+    AnimationSnapshot loaded;
+    QString error;
+    QVERIFY(!SpriteFile::read(&file, loaded, &error));
+    QVERIFY(!error.isEmpty());
+    file.close();
+
+    error.clear();
+    QVERIFY(!SpriteFileReader::open(file.fileName(), &error));
+    QVERIFY(!error.isEmpty());
+}
+
+///
+/// \brief SpriteFileTest::damagedDeltaBase_data bases that would make following a delta back never end
+///
+void SpriteFileTest::damagedDeltaBase_data()
+{
+    QTest::addColumn<bool>("baseIsItself");
+
+    QTest::newRow("base is the block itself") << true;
+    QTest::newRow("base is after the block") << false;
+}
+
+///
+/// \brief SpriteFileTest::damagedDeltaBase read() refuses a delta whose base isn't earlier in the file, and
+///        SpriteFileReader opens the file but decodes that frame as damaged while other frames still decode
+///
+void SpriteFileTest::damagedDeltaBase()
+{
+    QFETCH(bool, baseIsItself);
+
+    AnimationSnapshot snapshot = makeSnapshot(8, QSize(24, 16));
+    QTemporaryFile file;
+    writeFile(file, snapshot, SpriteFile::KEYFRAME_INTERVAL);
+    if (QTest::currentTestFailed())
+        return;
+    SpriteFile::Header header;
+    std::vector<SpriteFile::FrameEntry> entries = readTable(file.fileName(), header);
+    auto delta = std::find_if(entries.begin(), entries.end(), [](const SpriteFile::FrameEntry &entry)
+    {
+        return entry.encoding == SpriteFile::Encoding::Delta;
+    });
+    QVERIFY(delta != entries.end());
+    int damagedIndex = delta - entries.begin();
+
+    // a delta block starts with its base's table entry
+    quint64 base = baseIsItself ? delta->offset : header.indexOffset;
+    patchFile(file.fileName(), delta->offset, littleEndian(base, 8));
+    if (QTest::currentTestFailed())
+        return;
+
+    QVERIFY(file.open());
+    AnimationSnapshot loaded;
+    QString error;
+    QVERIFY(!SpriteFile::read(&file, loaded, &error));
+    QVERIFY(!error.isEmpty());
+    file.close();
+
+    std::shared_ptr<SpriteFileReader> reader = SpriteFileReader::open(file.fileName(), &error);
+    QVERIFY2(reader, qPrintable(error));
+    QVERIFY(reader->decodeFrame(damagedIndex).isNull());
+    QVERIFY(reader->decodeFrame(0) == snapshot.frames[0]);
+}
+
+///
+/// \brief baselineJson write a snapshot the way the editor did before the JSON format was streamed: through
+///        QJsonDocument, which sorts the keys, so the frames come before the size
+/// \param snapshot the animation; its frames must be square, as the old editor only wrote those correctly
+/// \param base64 write the version 2 rows instead of arrays of [r, g, b, a]
+/// \return the file's text
+///
+static QByteArray baselineJson(const AnimationSnapshot &snapshot, bool base64)
+{
+    QJsonObject frames;
+    for (size_t f = 0; f < snapshot.frames.size(); f++)
+    {
+        const QImage &canvas = snapshot.frames[f];
+        QJsonArray rows;
+        for (int y = 0; y < canvas.height(); y++)
+        {
+            if (base64)
+            {
+                QByteArray packed(canvas.width() * sizeof(QRgb), '\0');
+                qToLittleEndian<quint32>(canvas.constScanLine(y), canvas.width(), packed.data());
+                rows.append(QString::fromLatin1(packed.toBase64()));
+                continue;
+            }
+            QJsonArray row;
+            for (int x = 0; x < canvas.width(); x++)
+            {
+                QRgb px = canvas.pixel(x, y);
+                row.append(QJsonArray { qRed(px), qGreen(px), qBlue(px), qAlpha(px) });
+            }
+            rows.append(row);
+        }
+        frames["frame" + QString::number(f)] = rows;
+    }
+
+    QJsonObject sprite;
+    if (base64)
+        sprite["version"] = LegacySpriteFile::VERSION;
+    sprite["height"] = snapshot.frameSize.height();
+    sprite["width"] = snapshot.frameSize.width();
+    sprite["numberOfFrames"] = (int)snapshot.frames.size();
+    sprite["frames"] = frames;
+    return QJsonDocument(sprite).toJson(QJsonDocument::JsonFormat::Compact);
+}
+
+///
+/// \brief SpriteFileTest::legacyRead_data files from the old editor, with the frames before the size, and files
+///        LegacySpriteFile::write wrote, with the size first; in both row forms. There are more frames than the
+///        thread pool parses at once.
+///
+void SpriteFileTest::legacyRead_data()
+{
+    QTest::addColumn<QString>("writer");
+    QTest::addColumn<bool>("base64");
+
+    QTest::newRow("baseline, version 1") << "baseline" << false;
+    QTest::newRow("baseline, version 2") << "baseline" << true;
+    QTest::newRow("written, version 1") << "written" << false;
+    QTest::newRow("written, version 2") << "written" << true;
+}
+
+///
+/// \brief SpriteFileTest::legacyRead LegacySpriteFile::read gives back every frame as written
+///
+void SpriteFileTest::legacyRead()
+{
+    QFETCH(QString, writer);
+    QFETCH(bool, base64);
+
+    AnimationSnapshot snapshot = makeSnapshot(50, QSize(16, 16));
+    QByteArray text;
+    if (writer == "baseline")
+    {
+        text = baselineJson(snapshot, base64);
+        QVERIFY(text.indexOf("\"frames\"") < text.indexOf("\"height\""));
+    }
+    else
+    {
+        QBuffer written(&text);
+        QVERIFY(written.open(QIODevice::WriteOnly));
+        QString error;
+        QVERIFY2(LegacySpriteFile::write(&written, snapshot, &error,
+                                         base64 ? LegacySpriteFile::RowEncoding::Base64 : LegacySpriteFile::RowEncoding::Arrays),
+                 qPrintable(error));
+    }
+
+    QBuffer buffer(&text);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    AnimationSnapshot loaded;
+    QString error;
+    QVERIFY2(LegacySpriteFile::read(&buffer, loaded, &error), qPrintable(error));
+    QCOMPARE(loaded.frameSize, snapshot.frameSize);
+    compareFrames(loaded.frames, snapshot.frames);
+    if (QTest::currentTestFailed())
+        return;
+
+    // cut off partway through a frame, the file is damaged rather than short of frames
+    QByteArray truncated = text.left(text.size() / 2);
+    QBuffer damaged(&truncated);
+    QVERIFY(damaged.open(QIODevice::ReadOnly));
+    QVERIFY(!LegacySpriteFile::read(&damaged, loaded, &error));
+}
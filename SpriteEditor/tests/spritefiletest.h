@@ -0,0 +1,26 @@
+#ifndef SPRITEFILETEST_H
+#define SPRITEFILETEST_H
+
+#include <QObject>
+
+///
+/// \brief The SpriteFileTest class writes sprites in both file formats and reads them back every way the editor
+///        does, including files damaged on disk and JSON files written before the format was streamed.
+///
+class SpriteFileTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip_data();
+    void roundTrip();
+    void appendEditedFrame();
+    void damagedTable_data();
+    void damagedTable();
+    void damagedDeltaBase_data();
+    void damagedDeltaBase();
+    void legacyRead_data();
+    void legacyRead();
+};
+
+#endif // SPRITEFILETEST_H
@@ -0,0 +1,22 @@
+# Unit tests and benchmarks for the core library. "make check" runs them all; QTest's options, such as -iterations
+# or -callgrind, tune the benchmarks.
+TARGET = spiffysprites-tests
+
+QT       = core gui testlib
+
+CONFIG += c++17
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+include(../core/core.pri)
+
+SOURCES += \
+    animationtest.cpp \
+    kernelstest.cpp \
+    main.cpp \
+    spritefiletest.cpp
+
+HEADERS += \
+    animationtest.h \
+    kernelstest.h \
+    spritefiletest.h